@@ -0,0 +1,47 @@
+const child_process = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+// relative to this JS file
+// "../a-unpacked" is the same solution built from a revision before the bit-packed kernel
+const COMPILED_ALGORITHMS = [
+  { path: "../a-unpacked", maxN: 1000 },
+  { path: "../a", maxN: 2000 },
+];
+
+function genRandomInput(n) {
+  const lines = ["1", `${n}`];
+  for (let i = 0; i < n; i++) {
+    const row = [];
+    for (let j = 0; j < n; j++) {
+      row.push(Math.random() < 0.5 ? 0 : 1);
+    }
+    lines.push(row.join(" "));
+  }
+  return lines.join("\n") + "\n";
+}
+
+function timeAlgorithm(algorithmPath, inputPath) {
+  const start = process.hrtime.bigint();
+  const output = child_process.execSync(
+    `${path.join(__dirname, algorithmPath).replace(/ /g, "\\ ")} < ${inputPath}`
+  );
+  return {
+    time: Number(process.hrtime.bigint() - start) / 1e6,
+    output: output.toString().trim(),
+  };
+}
+
+for (const n of [100, 200, 500, 1000, 2000]) {
+  const inputPath = path.join(os.tmpdir(), `even-matrices-bench-${n}.txt`);
+  fs.writeFileSync(inputPath, genRandomInput(n));
+  for (const algorithm of COMPILED_ALGORITHMS) {
+    if (n > algorithm.maxN) {
+      continue;
+    }
+    const { time, output } = timeAlgorithm(algorithm.path, inputPath);
+    console.log(`n = ${n}, ${algorithm.path}: ${time.toFixed(1)} ms (${output})`);
+  }
+  fs.unlinkSync(inputPath);
+}
@@ -1,5 +1,8 @@
 #include <iostream>
 #include <vector>
+#include <cstdint>
+
+const int wordBits = 64;
 
 void printVec(std::vector<int> vec)
 {
@@ -14,21 +17,32 @@ void printVec(std::vector<int> vec)
   std::cout << '\n';
 }
 
-int countEvenIntervals(std::vector<int> values)
+// countEvenIntervals counts the intervals of columns whose sum between two rows of
+// cumulative parities is even. The parity of every prefix is computed inside each
+// word with a shift-xor scan, so a row pair takes O(n / 64) word operations.
+long countEvenIntervals(const uint64_t *row1, const uint64_t *row2, int n)
 {
-  int parity = 0, even = 1, odd = 0;
-  for (auto v : values)
+  int numWords = (n + wordBits - 1) / wordBits;
+  long odd = 0;
+  uint64_t carry = 0;
+  for (int w = 0; w < numWords; w++)
   {
-    parity = (parity + v) % 2;
-    if (parity == 0)
-    {
-      even++;
-    }
-    else
+    uint64_t prefix = row1[w] ^ row2[w];
+    prefix ^= prefix << 1;
+    prefix ^= prefix << 2;
+    prefix ^= prefix << 4;
+    prefix ^= prefix << 8;
+    prefix ^= prefix << 16;
+    prefix ^= prefix << 32;
+    prefix ^= carry;
+    carry = prefix >> (wordBits - 1) ? ~uint64_t(0) : 0;
+    if (w == numWords - 1 && n % wordBits != 0)
     {
-      odd++;
+      prefix &= (uint64_t(1) << (n % wordBits)) - 1;
     }
+    odd += __builtin_popcountll(prefix);
   }
+  long even = n + 1 - odd;
   return (even * (even - 1)) / 2 + (odd * (odd - 1)) / 2;
 }
 
@@ -36,31 +50,34 @@ void testcase()
 {
   int n;
   std::cin >> n;
-  std::vector<std::vector<int>> cumM{std::vector<int>(n, 0)};
+  int numWords = (n + wordBits - 1) / wordBits;
+
+  // row i of cumParity holds the column parities of the sum of the first i rows
+  std::vector<uint64_t> cumParity((n + 1) * numWords, 0);
   for (int i = 0; i < n; i++)
   {
-    auto row = cumM.back();
+    const uint64_t *prevRow = &cumParity[i * numWords];
+    uint64_t *row = &cumParity[(i + 1) * numWords];
+    for (int w = 0; w < numWords; w++)
+    {
+      row[w] = prevRow[w];
+    }
     for (int j = 0; j < n; j++)
     {
       int v;
       std::cin >> v;
-      row[j] += v;
+      row[j / wordBits] ^= uint64_t(v & 1) << (j % wordBits);
     }
-    cumM.push_back(row);
   }
 
-  int evenIntervals = 0;
+  long evenIntervals = 0;
   for (int i1 = 0; i1 < n; i1++)
   {
+    const uint64_t *row1 = &cumParity[i1 * numWords];
     for (int i2 = i1 + 1; i2 <= n; i2++)
     {
-      auto diff = cumM[i2];
-      for (int j = 0; j < n; j++)
-      {
-        diff[j] -= cumM[i1][j];
-      }
-
-      evenIntervals += countEvenIntervals(diff);
+      const uint64_t *row2 = &cumParity[i2 * numWords];
+      evenIntervals += countEvenIntervals(row1, row2, n);
     }
   }
 
@@ -0,0 +1,51 @@
+const child_process = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+// relative to this JS file
+// "../a-cin" is the same solution built from a revision that still reads with std::cin
+const COMPILED_ALGORITHM_PATHS = ["../a-cin", "../a"];
+
+function genRandomInput(t, n) {
+  const lines = [`${t}`];
+  for (let i = 0; i < t; i++) {
+    const positions = [];
+    for (let j = 0; j < n; j++) {
+      positions.push(Math.floor(Math.random() * 2000001) - 1000000);
+    }
+    lines.push(`${n}`, positions.join(" "));
+  }
+  return lines.join("\n") + "\n";
+}
+
+function timeAlgorithm(algorithmPath, inputPath) {
+  const start = process.hrtime.bigint();
+  child_process.execSync(
+    `${path.join(__dirname, algorithmPath).replace(/ /g, "\\ ")} < ${inputPath}`,
+    { stdio: ["ignore", "ignore", "inherit"] }
+  );
+  return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+function bench(t, n, runs) {
+  const inputPath = path.join(os.tmpdir(), `beach-bars-bench-${t}-${n}.txt`);
+  fs.writeFileSync(inputPath, genRandomInput(t, n));
+  for (const algorithmPath of COMPILED_ALGORITHM_PATHS) {
+    const times = [];
+    for (let i = 0; i < runs; i++) {
+      times.push(timeAlgorithm(algorithmPath, inputPath));
+    }
+    times.sort((a, b) => a - b);
+    console.log(
+      `t = ${t}, n = ${n}, ${algorithmPath}: median ${times[
+        Math.floor(runs / 2)
+      ].toFixed(1)} ms`
+    );
+  }
+  fs.unlinkSync(inputPath);
+}
+
+for (const n of [1000, 100000, 1000000]) {
+  bench(5, n, 5);
+}
@@ -3,95 +3,351 @@
 #include <vector>
 #include <assert.h>
 #include <algorithm>
-#include <deque>
 #include <limits>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 const int max_parasols = 1'000'000;
 const int beach_size = 2 * max_parasols + 1;
 const int beach_middle = beach_size / 2;
 const int max_near_distance = 100;
 
-void testcase()
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
 {
-  std::bitset<beach_size> parasols;
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
 
-  int n;
-  std::cin >> n;
-  assert(n >= 1 && n <= max_parasols);
-  for (int i = 0; i < n; i++)
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
+
+  int read_int()
   {
-    int v;
-    std::cin >> v;
-    v += beach_middle;
-    assert(v >= 0 && v < beach_size);
-    parasols.set(v);
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
   }
 
-  std::vector<int> nearby_customers_by_pos(beach_size, 0);
-  std::vector<int> longest_walk_by_pos(beach_size, -1);
-  std::deque<int> nearby_customers;
-  for (int bar = -max_near_distance; bar < beach_size + max_near_distance; bar++)
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
   {
-    int new_customer_pos = bar + max_near_distance;
-    assert(new_customer_pos >= 0);
-    if (new_customer_pos < beach_size && parasols.test(new_customer_pos))
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
     {
-      nearby_customers.push_front(new_customer_pos);
+      pos++;
     }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
 
-    int old_customer_pos = bar - max_near_distance - 1;
-    assert(old_customer_pos < beach_size);
-    if (old_customer_pos >= 0 && parasols.test(old_customer_pos))
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
     {
-      nearby_customers.pop_back();
+      pos++;
     }
+    return std::string(start, pos);
+  }
 
-    if (bar >= 0 && bar < beach_size)
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
     {
-      nearby_customers_by_pos.at(bar) = nearby_customers.size();
+      pos++;
+    }
+  }
 
-      if (nearby_customers.size() > 0)
-      {
-        longest_walk_by_pos.at(bar) = std::max(abs(nearby_customers.front() - bar), abs(nearby_customers.back() - bar));
-      }
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
     }
   }
 
-  int max_nearby_customers = *std::max_element(nearby_customers_by_pos.begin(), nearby_customers_by_pos.end());
-  assert(max_nearby_customers >= 1);
-  int min_relevant_walk = std::numeric_limits<int>::max();
-  for (int i = 0; i < beach_size; i++)
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
+{
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
   {
-    if (nearby_customers_by_pos.at(i) == max_nearby_customers)
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
     {
-      min_relevant_walk = std::min({min_relevant_walk, longest_walk_by_pos.at(i)});
+      write_char(*s++);
     }
   }
-  assert(min_relevant_walk >= 0 && min_relevant_walk < std::numeric_limits<int>::max());
-  std::cout << max_nearby_customers << " " << min_relevant_walk << "\n";
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
+// Above this many parasols it is cheaper to get their sorted positions by scanning a
+// bitset of the whole beach, which takes beach_size / 64 word operations, than by sorting.
+const int min_parasols_for_dense_mode = beach_size / 64;
+
+void sort_parasols_sparse(std::vector<int> &parasol_positions)
+{
+  std::sort(parasol_positions.begin(), parasol_positions.end());
+  parasol_positions.erase(std::unique(parasol_positions.begin(), parasol_positions.end()), parasol_positions.end());
+}
+
+void sort_parasols_dense(std::vector<int> &parasol_positions)
+{
+  std::bitset<beach_size> parasols;
+  for (int v : parasol_positions)
+  {
+    parasols.set(v + beach_middle);
+  }
+
+  parasol_positions.clear();
+  for (size_t v = parasols._Find_first(); v < parasols.size(); v = parasols._Find_next(v))
+  {
+    parasol_positions.push_back(int(v) - beach_middle);
+  }
+}
+
+void testcase()
+{
+  int n = input.read_int();
+  assert(n >= 1 && n <= max_parasols);
+  std::vector<int> parasol_positions(n);
+  for (int &v : parasol_positions)
+  {
+    v = input.read_int();
+    assert(v + beach_middle >= 0 && v + beach_middle < beach_size);
+  }
+
+  if (n >= min_parasols_for_dense_mode)
+  {
+    sort_parasols_dense(parasol_positions);
+  }
+  else
+  {
+    sort_parasols_sparse(parasol_positions);
+  }
+  n = parasol_positions.size();
+
+  // The customers of a bar are always a window of consecutive parasols which are at most
+  // 2 * max_near_distance apart. The shortest longest walk for serving a window is half
+  // (rounded up) of the window's span, reached by the one or two bars in its middle.
+  int max_nearby_customers = 0;
+  for (int i_first = 0, i_last = 0; i_first < n; i_first++)
+  {
+    while (i_last + 1 < n && parasol_positions.at(i_last + 1) - parasol_positions.at(i_first) <= 2 * max_near_distance)
+    {
+      i_last++;
+    }
+    max_nearby_customers = std::max(max_nearby_customers, i_last - i_first + 1);
+  }
+  assert(max_nearby_customers >= 1);
+
+  const auto window_span = [&parasol_positions, max_nearby_customers](int i_first) {
+    return parasol_positions.at(i_first + max_nearby_customers - 1) - parasol_positions.at(i_first);
+  };
+
+  int min_relevant_walk = std::numeric_limits<int>::max();
+  for (int i_first = 0; i_first + max_nearby_customers <= n; i_first++)
+  {
+    min_relevant_walk = std::min(min_relevant_walk, (window_span(i_first) + 1) / 2);
+  }
+  assert(min_relevant_walk >= 0 && min_relevant_walk <= max_near_distance);
+  output.write_int(max_nearby_customers);
+  output.write_char(' ');
+  output.write_int(min_relevant_walk);
+  output.write_char('\n');
 
   bool needs_space = false;
-  for (int i = 0; i < beach_size; i++)
+  for (int i_first = 0; i_first + max_nearby_customers <= n; i_first++)
   {
-    if (nearby_customers_by_pos.at(i) == max_nearby_customers && longest_walk_by_pos.at(i) == min_relevant_walk)
+    if ((window_span(i_first) + 1) / 2 != min_relevant_walk)
+    {
+      continue;
+    }
+    int i_last = i_first + max_nearby_customers - 1;
+    for (int bar = parasol_positions.at(i_last) - min_relevant_walk; bar <= parasol_positions.at(i_first) + min_relevant_walk; bar++)
     {
       if (needs_space)
       {
-        std::cout << " ";
+        output.write_char(' ');
       }
-      std::cout << i - beach_middle;
+      output.write_int(bar);
       needs_space = true;
     }
   }
-  std::cout << "\n";
+  output.write_char('\n');
 }
 
 int main()
 {
   std::ios_base::sync_with_stdio(false);
 
-  int n;
-  std::cin >> n;
+  int n = input.read_int();
   for (int i = 0; i < n; i++)
   {
     testcase();
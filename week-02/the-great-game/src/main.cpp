@@ -1,72 +1,299 @@
 #include <iostream>
-#include <map>
 #include <vector>
 #include <assert.h>
 #include <algorithm>
+#include <limits>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 const int debug_level = 1;
 
 const int red_meeple = 0;
 const int black_meeple = 1;
-const int dp_unknown = -1;
 
-typedef std::multimap<int, int> AdjacencyList;
-typedef std::vector<std::vector<std::vector<int>>> DpTable;
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
+{
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
 
-DpTable dp_table;
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
 
-inline int get_other_meeple(int meeple)
-{
-  assert(meeple == red_meeple || meeple == black_meeple);
-  return meeple == red_meeple ? black_meeple : red_meeple;
-}
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
 
-int calc_ideal_path_length(AdjacencyList &fw_transitions, int starting_pos, int starting_player, int long_player);
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
 
-int _calc_ideal_path_length(AdjacencyList &fw_transitions, int starting_pos, int starting_player, int long_player)
-{
-  auto transitions = fw_transitions.equal_range(starting_pos);
-  if (transitions.first == transitions.second)
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
   {
-    return 0;
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
   }
-  std::vector<int> choice_lengths;
-  for (auto it = transitions.first; it != transitions.second; it++)
+
+  std::string read_string()
   {
-    choice_lengths.push_back(calc_ideal_path_length(fw_transitions, it->second, get_other_meeple(starting_player), long_player));
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
   }
-  if (starting_player == long_player)
+
+  void skip_line()
   {
-    return *std::max_element(choice_lengths.begin(), choice_lengths.end()) + 1;
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
   }
-  else
+
+private:
+  void skip_whitespace()
   {
-    return *std::min_element(choice_lengths.begin(), choice_lengths.end()) + 1;
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
   }
-}
 
-int calc_ideal_path_length(AdjacencyList &fw_transitions, int starting_pos, int starting_player, int long_player)
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
 {
-  int result = dp_table.at(long_player).at(starting_player).at(starting_pos);
-  if (result == dp_unknown)
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
   {
-    result = _calc_ideal_path_length(fw_transitions, starting_pos, starting_player, long_player);
-    dp_table.at(long_player).at(starting_player).at(starting_pos) = result;
+    flush();
   }
-  return result;
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
+    {
+      write_char(*s++);
+    }
+  }
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
+// Transitions stores the moves out of every position in CSR form: the moves out of
+// position u are targets[offsets[u]] up to (excluding) targets[offsets[u + 1]].
+struct Transitions
+{
+  std::vector<int> offsets, targets;
+};
+
+inline int get_other_meeple(int meeple)
+{
+  assert(meeple == red_meeple || meeple == black_meeple);
+  return meeple == red_meeple ? black_meeple : red_meeple;
 }
 
-void init_dp_table(int n)
+// IdealPathLengths holds, for every position, how many more moves a meeple at that
+// position will make if both players play ideally. In long_path_lengths it's the
+// turn of the player who wants this meeple's path to be long, in short_path_lengths
+// it's the turn of the player who wants it to be short.
+struct IdealPathLengths
+{
+  std::vector<int> long_path_lengths, short_path_lengths;
+};
+
+// calc_ideal_path_lengths fills in all positions in one sweep from the last position
+// to the first. This works because every move goes to a higher position.
+IdealPathLengths calc_ideal_path_lengths(const Transitions &transitions, int n)
 {
-  dp_table.clear();
-  for (int long_player = red_meeple; long_player <= black_meeple; long_player++)
+  IdealPathLengths result;
+  result.long_path_lengths.assign(n, 0);
+  result.short_path_lengths.assign(n, 0);
+  for (int pos = n - 1; pos >= 0; pos--)
   {
-    dp_table.push_back(std::vector<std::vector<int>>());
-    for (int starting_player = red_meeple; starting_player <= black_meeple; starting_player++)
+    int begin = transitions.offsets.at(pos), end = transitions.offsets.at(pos + 1);
+    if (begin == end)
     {
-      dp_table.back().push_back(std::vector<int>(n, dp_unknown));
+      continue;
     }
+    int longest = 0, shortest = std::numeric_limits<int>::max();
+    for (int i = begin; i < end; i++)
+    {
+      int next_pos = transitions.targets[i];
+      assert(next_pos > pos);
+      longest = std::max(longest, result.short_path_lengths[next_pos]);
+      shortest = std::min(shortest, result.long_path_lengths[next_pos]);
+    }
+    result.long_path_lengths[pos] = longest + 1;
+    result.short_path_lengths[pos] = shortest + 1;
   }
+  return result;
 }
 
 int game_length_from_path_length(int path_length, int meeple_color)
@@ -76,7 +303,7 @@ int game_length_from_path_length(int path_length, int meeple_color)
   {
     if (debug_level >= 3)
     {
-      std::cout << "i = " << i << ", t = " << t << ", cur_player = " << cur_player << "\n";
+      std::cerr << "i = " << i << ", t = " << t << ", cur_player = " << cur_player << "\n";
     }
     if (t == path_length && cur_player == meeple_color)
     {
@@ -88,7 +315,7 @@ int game_length_from_path_length(int path_length, int meeple_color)
 
     if (debug_level >= 3)
     {
-      std::cout << "i = " << i << ", t = " << t << ", cur_player = " << cur_player << "\n";
+      std::cerr << "i = " << i << ", t = " << t << ", cur_player = " << cur_player << "\n";
     }
     if (t == path_length && cur_player == meeple_color)
     {
@@ -102,74 +329,84 @@ int game_length_from_path_length(int path_length, int meeple_color)
 
 void testcase()
 {
-  int n, m, red_start, black_start;
-  std::cin >> n >> m >> red_start >> black_start;
+  int n = input.read_int(), m = input.read_int(), red_start = input.read_int(), black_start = input.read_int();
   assert(n >= 2 && m >= 1);
   assert(red_start >= 1 && red_start <= n - 1);
   assert(black_start >= 1 && black_start <= n - 1);
   red_start--;
   black_start--;
 
-  AdjacencyList fw_transitions, bw_transitions;
-  for (int i = 0; i < m; i++)
+  std::vector<std::pair<int, int>> edges(m);
+  Transitions transitions;
+  transitions.offsets.assign(n + 1, 0);
+  for (auto &edge : edges)
   {
-    int u, v;
-    std::cin >> u >> v;
+    int u = input.read_int(), v = input.read_int();
     assert(u >= 1 && u < v && v <= n);
     u--;
     v--;
-    fw_transitions.insert(std::make_pair(u, v));
-    bw_transitions.insert(std::make_pair(v, u));
+    edge = std::make_pair(u, v);
+    transitions.offsets.at(u + 1)++;
+  }
+  for (int pos = 0; pos < n; pos++)
+  {
+    transitions.offsets.at(pos + 1) += transitions.offsets.at(pos);
+  }
+  transitions.targets.resize(m);
+  std::vector<int> next_free_slot(transitions.offsets.begin(), transitions.offsets.end() - 1);
+  for (auto &edge : edges)
+  {
+    transitions.targets.at(next_free_slot.at(edge.first)++) = edge.second;
   }
-  assert(int(fw_transitions.size()) == m && int(bw_transitions.size()) == m);
 
   if (debug_level >= 3)
   {
-    std::cout << "fw_transitions\n";
-    for (auto entry : fw_transitions)
-    {
-      std::cout << entry.first << ' ' << entry.second << '\n';
-    }
-    std::cout << "bw_transitions\n";
-    for (auto entry : bw_transitions)
+    std::cerr << "transitions\n";
+    for (int pos = 0; pos < n; pos++)
     {
-      std::cout << entry.first << ' ' << entry.second << '\n';
+      for (int i = transitions.offsets.at(pos); i < transitions.offsets.at(pos + 1); i++)
+      {
+        std::cerr << pos << ' ' << transitions.targets.at(i) << '\n';
+      }
     }
   }
 
-  init_dp_table(n);
-  int red_path_length = calc_ideal_path_length(fw_transitions, red_start, red_meeple, black_meeple);
-  int black_path_length = calc_ideal_path_length(fw_transitions, black_start, black_meeple, red_meeple);
+  // Each player moves their own meeple to reach the target quickly and the other
+  // meeple to keep it away from the target. So for both meeples it's the turn of the
+  // "short" player first.
+  IdealPathLengths ideal_path_lengths = calc_ideal_path_lengths(transitions, n);
+  int red_path_length = ideal_path_lengths.short_path_lengths.at(red_start);
+  int black_path_length = ideal_path_lengths.short_path_lengths.at(black_start);
   if (debug_level >= 2)
   {
-    std::cout << "red_path_length " << red_path_length << "\n";
-    std::cout << "black_path_length " << black_path_length << "\n";
+    std::cerr << "red_path_length " << red_path_length << "\n";
+    std::cerr << "black_path_length " << black_path_length << "\n";
   }
 
   int red_game_length = game_length_from_path_length(red_path_length, red_meeple);
   int black_game_length = game_length_from_path_length(black_path_length, black_meeple);
   if (debug_level >= 2)
   {
-    std::cout << "red_game_length " << red_game_length << "\n";
-    std::cout << "black_game_length " << black_game_length << "\n";
+    std::cerr << "red_game_length " << red_game_length << "\n";
+    std::cerr << "black_game_length " << black_game_length << "\n";
   }
   assert(red_game_length != black_game_length);
 
   int winner = red_game_length < black_game_length ? red_meeple : black_meeple;
-  std::cout << winner << "\n";
+  output.write_int(winner);
+  output.write_char('\n');
 }
 
 int main()
 {
   std::ios_base::sync_with_stdio(false);
 
-  int n;
-  std::cin >> n;
+  int n = input.read_int();
   for (int i = 0; i < n; i++)
   {
     if (debug_level >= 2)
     {
-      std::cout << "test case " << i << '\n';
+      std::cerr << "test case " << i << '\n';
     }
     testcase();
   }
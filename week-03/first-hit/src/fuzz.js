@@ -0,0 +1,175 @@
+const child_process = require("child_process");
+const path = require("path");
+
+const COMPILED_ALGORITHM_PATH = "../a"; // relative to this JS file
+
+const MAX_ABS_COORDINATE = 2 ** 51 - 1;
+
+function algorithmCpp(input) {
+  const inputLines = [
+    `${input.walls.length}`,
+    `${input.origin[0]} ${input.origin[1]} ${input.through[0]} ${input.through[1]}`,
+  ];
+  for (const wall of input.walls) {
+    inputLines.push(wall.join(" "));
+  }
+  inputLines.push("0");
+
+  const output = child_process.execSync(
+    path.join(__dirname, COMPILED_ALGORITHM_PATH).replace(/ /g, "\\ "),
+    { input: inputLines.join("\n") }
+  );
+
+  return output.toString().trim();
+}
+
+function floorDiv(a, b) {
+  if (b < 0n) {
+    a = -a;
+    b = -b;
+  }
+  return a >= 0n ? a / b : -((-a + b - 1n) / b);
+}
+
+function cross(u, v) {
+  return u[0] * v[1] - u[1] * v[0];
+}
+
+function dot(u, v) {
+  return u[0] * v[0] + u[1] * v[1];
+}
+
+// firstHitGolden checks every wall with exact BigInt arithmetic. The ray is
+// origin + lambda * direction, and hits are compared by lambda = [numerator, denominator]
+// with a positive denominator.
+function firstHitGolden(input) {
+  const origin = input.origin.map(BigInt);
+  const direction = [0, 1].map((i) => BigInt(input.through[i]) - origin[i]);
+  let best = null;
+  const consider = (numerator, denominator) => {
+    if (denominator < 0n) {
+      numerator = -numerator;
+      denominator = -denominator;
+    }
+    if (best === null || numerator * best[1] < best[0] * denominator) {
+      best = [numerator, denominator];
+    }
+  };
+
+  for (const wall of input.walls) {
+    const s = [BigInt(wall[0]), BigInt(wall[1])];
+    const t = [BigInt(wall[2]), BigInt(wall[3])];
+    const e = [t[0] - s[0], t[1] - s[1]];
+    const so = [s[0] - origin[0], s[1] - origin[1]];
+    const denominator = cross(direction, e);
+    if (denominator !== 0n) {
+      // lambda = cross(so, e) / denominator, mu = cross(so, direction) / denominator
+      let lambda = cross(so, e);
+      let mu = cross(so, direction);
+      let d = denominator;
+      if (d < 0n) {
+        lambda = -lambda;
+        mu = -mu;
+        d = -d;
+      }
+      if (lambda >= 0n && mu >= 0n && mu <= d) {
+        consider(lambda, d);
+      }
+    } else if (cross(so, direction) === 0n) {
+      // collinear: the closest point of the wall which is on the ray
+      const dd = dot(direction, direction);
+      const lambdaS = dot(so, direction);
+      const lambdaT = dot([t[0] - origin[0], t[1] - origin[1]], direction);
+      const lambdaMin = lambdaS < lambdaT ? lambdaS : lambdaT;
+      const lambdaMax = lambdaS < lambdaT ? lambdaT : lambdaS;
+      if (lambdaMax >= 0n) {
+        consider(lambdaMin > 0n ? lambdaMin : 0n, dd);
+      }
+    }
+  }
+
+  if (best === null) {
+    return "no";
+  }
+  const [numerator, denominator] = best;
+  return [0, 1]
+    .map((i) => floorDiv(origin[i] * denominator + numerator * direction[i], denominator))
+    .join(" ");
+}
+
+function randomInt(min, max) {
+  return min + Math.floor(Math.random() * (max - min + 1));
+}
+
+function randomFarCoordinate() {
+  return (Math.random() < 0.5 ? -1 : 1) * randomInt(2 ** 40, MAX_ABS_COORDINATE);
+}
+
+// genRandomInput puts the walls into a small box, and the ray origin far away from it
+// (up to 2^51), pointing at a random point of the box. The grid cells are then much
+// smaller than the rounding errors of the ray's coordinates.
+function genRandomInput(n) {
+  const boxSize = 100;
+  const walls = [];
+  for (let i = 0; i < n; i++) {
+    const x = randomInt(0, boxSize), y = randomInt(0, boxSize);
+    walls.push([x, y, x + randomInt(-2, 2), y + randomInt(-2, 2)]);
+  }
+  const origin = [randomFarCoordinate(), randomFarCoordinate()];
+  if (Math.random() < 0.5) {
+    origin[randomInt(0, 1)] = randomInt(0, boxSize);
+  }
+  const through = [randomInt(0, boxSize), randomInt(0, boxSize)];
+  return { origin, through, walls };
+}
+
+// genCornerInput aims a ray from (1 - p, 1 + q) at the corner of a grid cell. The walls
+// span [0, 19]^2 in a 20 x 20 grid, so there is a cell corner at (0.95, 0.95), and the
+// only wall the ray hits, (1, 1) to (1, 2), is inside the cell above and right of that
+// corner. The ray clips that cell by less than 0.1, which is about the rounding error of
+// a line through a point at distance 2^50.
+function genCornerInput(
+  p = randomInt(2 ** 49, 2 ** 50),
+  q = p + randomInt(-Math.floor(p / 20), Math.floor(p / 20))
+) {
+  const walls = [[1, 1, 1, 2]];
+  while (walls.length < 400) {
+    walls.push([18, 19, 19, 19], [0, 18, 0, 19], [19, 0, 18, 0]);
+  }
+  return { origin: [1 - p, 1 + q], through: [1, 1], walls };
+}
+
+// FAR_ORIGIN_INPUTS are inputs on which a grid margin which ignores the ray origin
+// skipped the cell with the first hit
+const FAR_ORIGIN_INPUTS = [genCornerInput(567397634604837, 562862810696981)];
+
+function fuzz(maxBadInputs, minN, maxN) {
+  const badInputs = [];
+  for (const input of FAR_ORIGIN_INPUTS) {
+    const expected = firstHitGolden(input);
+    const actual = algorithmCpp(input);
+    if (actual !== expected) {
+      badInputs.push({ input, expected, actual });
+      if (badInputs.length === maxBadInputs) {
+        return badInputs;
+      }
+    }
+  }
+  for (let n = minN; n <= maxN; n *= 2) {
+    console.log(`n = ${n}`);
+    for (let j = 0; j < 200; j++) {
+      const input = j % 2 === 0 ? genRandomInput(n) : genCornerInput();
+      const expected = firstHitGolden(input);
+      const actual = algorithmCpp(input);
+      if (actual !== expected) {
+        badInputs.push({ input, expected, actual });
+        if (badInputs.length === maxBadInputs) {
+          return badInputs;
+        }
+      }
+    }
+  }
+  return badInputs;
+}
+
+console.log(fuzz(1, 16, 4096)[0]);
@@ -2,11 +2,326 @@
 #include <CGAL/Exact_predicates_exact_constructions_kernel.h>
 #include <limits>
 #include <algorithm>
+#include <string>
+#include <cmath>
+#include <vector>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 const int debug_level = 0;
 
 typedef CGAL::Exact_predicates_exact_constructions_kernel K;
 
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
+{
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
+
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
+
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
+
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
+
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
+  }
+
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
+  }
+
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
+{
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
+  {
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
+    {
+      write_char(*s++);
+    }
+  }
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
+// The filtered predicates below decide with plain doubles whenever the rounding error
+// provably can't change the answer, and report filter_unsure otherwise. Only walls
+// which the filter can't rule out are intersected with the exact kernel. The error bound is the one from Shewchuk's
+// "Adaptive Precision Floating-Point Arithmetic" for 2D orientation, which also holds
+// for any (b - a) x (d - c) with double inputs.
+enum FilterResult
+{
+  filter_no,
+  filter_yes,
+  filter_unsure
+};
+
+struct FilterStats
+{
+  long bbox_rejects = 0, filter_rejects = 0, filter_accepts = 0, exact_fallbacks = 0, exact_intersections = 0;
+};
+
+FilterStats filter_stats;
+
+// filtered_cross_sign returns the sign of (b - a) x (d - c), or 0 if it's uncertain
+inline int filtered_cross_sign(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy)
+{
+  const double error_bound_factor = 3.3306690738754716e-16;
+  const double left = (bx - ax) * (dy - cy), right = (by - ay) * (dx - cx);
+  const double det = left - right, error_bound = error_bound_factor * (std::abs(left) + std::abs(right));
+  if (det > error_bound)
+  {
+    return 1;
+  }
+  if (-det > error_bound)
+  {
+    return -1;
+  }
+  return 0;
+}
+
+// filtered_ray_hits_segment decides whether the ray from o through t hits the segment pq
+FilterResult filtered_ray_hits_segment(double ox, double oy, double tx, double ty, double px, double py, double qx, double qy)
+{
+  if ((tx > ox && std::max(px, qx) < ox) || (tx < ox && std::min(px, qx) > ox) || (ty > oy && std::max(py, qy) < oy) || (ty < oy && std::min(py, qy) > oy))
+  {
+    filter_stats.bbox_rejects++;
+    return filter_no;
+  }
+
+  // p and q strictly on the same side of the ray's line
+  const int p_side = filtered_cross_sign(ox, oy, tx, ty, ox, oy, px, py), q_side = filtered_cross_sign(ox, oy, tx, ty, ox, oy, qx, qy);
+  if (p_side != 0 && p_side == q_side)
+  {
+    filter_stats.filter_rejects++;
+    return filter_no;
+  }
+
+  // the segment's line is crossed ahead of o if moving along the ray brings o closer to it
+  const int o_side = filtered_cross_sign(px, py, qx, qy, px, py, ox, oy), ray_side = filtered_cross_sign(px, py, qx, qy, ox, oy, tx, ty);
+  if (p_side != 0 && q_side != 0 && o_side != 0 && ray_side != 0)
+  {
+    if (o_side != ray_side)
+    {
+      filter_stats.filter_accepts++;
+      return filter_yes;
+    }
+    filter_stats.filter_rejects++;
+    return filter_no;
+  }
+
+  filter_stats.exact_fallbacks++;
+  return filter_unsure;
+}
+
+void print_filter_stats()
+{
+  std::cerr << "bbox_rejects " << filter_stats.bbox_rejects << " filter_rejects " << filter_stats.filter_rejects
+            << " filter_accepts " << filter_stats.filter_accepts << " exact_fallbacks " << filter_stats.exact_fallbacks
+            << " exact_intersections " << filter_stats.exact_intersections << "\n";
+}
+
 double floor_to_double(const K::FT &x)
 {
   double a = std::floor(CGAL::to_double(x));
@@ -21,86 +336,308 @@ double floor_to_double(const K::FT &x)
   return a;
 }
 
-bool testcase()
+// WallGrid buckets walls into a uniform grid with about one cell per wall, so that a
+// ray only has to be checked against the walls in the cells it passes through, in the
+// order it passes through them. Cells are chosen with doubles, but always with a
+// safety margin which covers the rounding errors of the ray's coordinates as well as
+// the walls', so the hits (which use the exact kernel) are still exact. A WallGrid can
+// be built once and then queried with any number of rays.
+class WallGrid
 {
-  int n;
-  std::cin >> n;
-  if (n == 0)
+public:
+  WallGrid(const std::vector<K::Segment_2> &walls) : walls(walls), last_query_by_wall(walls.size(), -1), num_queries(0)
   {
-    return false;
+    assert(!walls.empty());
+    max_abs_coordinate = 1;
+    for (int axis = 0; axis < 2; axis++)
+    {
+      bounds_min[axis] = std::numeric_limits<double>::max();
+      bounds_max[axis] = std::numeric_limits<double>::lowest();
+    }
+    for (const K::Segment_2 &wall : walls)
+    {
+      for (const K::Point_2 &p : {wall.source(), wall.target()})
+      {
+        const double coordinates[2] = {CGAL::to_double(p.x()), CGAL::to_double(p.y())};
+        for (int axis = 0; axis < 2; axis++)
+        {
+          bounds_min[axis] = std::min(bounds_min[axis], coordinates[axis]);
+          bounds_max[axis] = std::max(bounds_max[axis], coordinates[axis]);
+          max_abs_coordinate = std::max(max_abs_coordinate, std::abs(coordinates[axis]));
+        }
+      }
+    }
+    wall_margin = margin_for(max_abs_coordinate);
+
+    cells_per_axis = std::max(1, int(std::ceil(std::sqrt(double(walls.size())))));
+    for (int axis = 0; axis < 2; axis++)
+    {
+      cell_size[axis] = (bounds_max[axis] - bounds_min[axis]) / cells_per_axis;
+      if (cell_size[axis] <= 0)
+      {
+        cell_size[axis] = 1;
+      }
+    }
+
+    cell_offsets.assign(cells_per_axis * cells_per_axis + 1, 0);
+    for (const K::Segment_2 &wall : walls)
+    {
+      visit_cells_on_wall(wall, [this](int cell) {
+        cell_offsets.at(cell + 1)++;
+      });
+    }
+    for (int cell = 0; cell < cells_per_axis * cells_per_axis; cell++)
+    {
+      cell_offsets.at(cell + 1) += cell_offsets.at(cell);
+    }
+    cell_walls.resize(cell_offsets.back());
+    std::vector<int> next_free_slot(cell_offsets.begin(), cell_offsets.end() - 1);
+    for (int i = 0; i < int(walls.size()); i++)
+    {
+      visit_cells_on_wall(walls.at(i), [this, i, &next_free_slot](int cell) {
+        cell_walls.at(next_free_slot.at(cell)++) = i;
+      });
+    }
   }
-  assert(n >= 1 && n <= 30'000);
 
-  double x, y, a, b;
-  std::cin >> x >> y >> a >> b;
-  K::Point_2 ray_origin(x, y);
-  K::Ray_2 ray(ray_origin, K::Point_2(a, b));
+  // find_first_hit returns whether the ray hits any wall. If it does, closest_hit is
+  // set to the hit which is closest to the ray origin.
+  bool find_first_hit(const K::Ray_2 &ray, K::Point_2 &closest_hit)
+  {
+    const int query = num_queries++;
+    const K::Point_2 &ray_origin = ray.source();
+    bool did_intersect = false;
 
-  std::vector<K::Segment_2> walls;
-  for (int i = 0; i < n; i++)
+    auto inspect_hit_point = [&did_intersect, &closest_hit, &ray_origin](const K::Point_2 &hit_point) {
+      if (!did_intersect || CGAL::has_smaller_distance_to_point(ray_origin, hit_point, closest_hit))
+      {
+        if (debug_level >= 2)
+        {
+          std::cerr << "closer\n";
+        }
+        closest_hit = hit_point;
+        did_intersect = true;
+      }
+    };
+
+    const K::Point_2 ray_through = ray.point(1);
+    const double origin[2] = {CGAL::to_double(ray_origin.x()), CGAL::to_double(ray_origin.y())};
+    const double through[2] = {CGAL::to_double(ray_through.x()), CGAL::to_double(ray_through.y())};
+    const double direction[2] = {through[0] - origin[0], through[1] - origin[1]};
+    // the ray origin can be much further out than the walls, and the cell computations
+    // along the ray are only as precise as its largest coordinate
+    const double query_margin = margin_for(std::max({max_abs_coordinate, std::abs(origin[0]), std::abs(origin[1]), std::abs(through[0]), std::abs(through[1])}));
+
+    auto check_wall = [&](const K::Segment_2 &wall) {
+      // walls are built from doubles, so their coordinates convert to double exactly
+      if (filtered_ray_hits_segment(origin[0], origin[1], through[0], through[1],
+                                    CGAL::to_double(wall.source().x()), CGAL::to_double(wall.source().y()),
+                                    CGAL::to_double(wall.target().x()), CGAL::to_double(wall.target().y())) == filter_no)
+      {
+        return;
+      }
+
+      filter_stats.exact_intersections++;
+      K::Segment_2 ray_segment(ray_origin, closest_hit);
+      if (!(did_intersect ? CGAL::do_intersect(ray_segment, wall) : CGAL::do_intersect(ray, wall)))
+      {
+        return;
+      }
+
+      auto generic_intersection = did_intersect ? CGAL::intersection(ray_segment, wall) : CGAL::intersection(ray, wall);
+      if (const K::Point_2 *hit_point = boost::get<K::Point_2>(&*generic_intersection))
+      {
+        if (debug_level >= 2)
+        {
+          std::cerr << "hit point " << *hit_point << "\n";
+        }
+        inspect_hit_point(*hit_point);
+      }
+      else if (const K::Segment_2 *hit_segment = boost::get<K::Segment_2>(&*generic_intersection))
+      {
+        if (debug_level >= 2)
+        {
+          std::cerr << "hit segment " << *hit_segment << "\n";
+        }
+        inspect_hit_point(hit_segment->source());
+        inspect_hit_point(hit_segment->target());
+      }
+      else
+      {
+        assert(false);
+      }
+    };
+
+    const int main_axis = std::abs(direction[0]) >= std::abs(direction[1]) ? 0 : 1;
+
+    // Every hit closer than closest_hit is at most as far along the main axis. Once
+    // the walk has passed closest_hit along the main axis, all those hits have been seen.
+    const auto is_past_closest_hit = [&](double slab_end) {
+      if (!did_intersect)
+      {
+        return false;
+      }
+      const double closest_hit_main = CGAL::to_double(main_axis == 0 ? closest_hit.x() : closest_hit.y());
+      return direction[main_axis] > 0 ? closest_hit_main < slab_end - query_margin : closest_hit_main > slab_end + query_margin;
+    };
+
+    const auto check_walls_in_cell = [&](int cell) {
+      for (int i = cell_offsets.at(cell); i < cell_offsets.at(cell + 1); i++)
+      {
+        int wall = cell_walls.at(i);
+        if (last_query_by_wall.at(wall) != query)
+        {
+          last_query_by_wall.at(wall) = query;
+          check_wall(walls.at(wall));
+        }
+      }
+    };
+
+    visit_cells_on_line(origin, direction, 0, std::numeric_limits<double>::infinity(), query_margin, check_walls_in_cell, is_past_closest_hit);
+    return did_intersect;
+  }
+
+private:
+  // margin_for returns the safety margin for cell computations on coordinates of at
+  // most max_abs_coordinate. Their rounding error is a few ulps of that.
+  static double margin_for(double max_abs_coordinate)
   {
-    double r, s, t, u;
-    std::cin >> r >> s >> t >> u;
-    K::Segment_2 wall(K::Point_2(r, s), K::Point_2(t, u));
-    walls.push_back(wall);
+    return 1e-12 * max_abs_coordinate;
+  }
+
+  template <typename VisitCell>
+  void visit_cells_on_wall(const K::Segment_2 &wall, VisitCell visit_cell)
+  {
+    const double start[2] = {CGAL::to_double(wall.source().x()), CGAL::to_double(wall.source().y())};
+    const double direction[2] = {CGAL::to_double(wall.target().x()) - start[0], CGAL::to_double(wall.target().y()) - start[1]};
+    visit_cells_on_line(start, direction, 0, 1, wall_margin, visit_cell, [](double) { return false; });
   }
 
-  std::random_shuffle(walls.begin(), walls.end());
+  // cell_range sets first and last to the range of cell indices along axis which
+  // overlap [from - margin, to + margin]. Returns false if there are none.
+  bool cell_range(int axis, double from, double to, double margin, int &first, int &last) const
+  {
+    double first_exact = std::floor((from - margin - bounds_min[axis]) / cell_size[axis]);
+    double last_exact = std::floor((to + margin - bounds_min[axis]) / cell_size[axis]);
+    if (last_exact < 0 || first_exact >= cells_per_axis)
+    {
+      return false;
+    }
+    first = std::max(0.0, first_exact);
+    last = std::min(double(cells_per_axis - 1), last_exact);
+    return true;
+  }
 
-  bool did_intersect = false;
-  K::Point_2 closest_intersection;
+  // visit_cells_on_line calls visit_cell for every cell near the line from
+  // start + t_begin * direction to start + t_end * direction. The cells are visited in
+  // slabs perpendicular to the axis along which the line changes fastest, in the order
+  // in which the line passes through the slabs. After each slab, the walk stops if
+  // stop_after_slab returns true for the coordinate where the slab ends. margin must
+  // cover the rounding errors of coordinates on the line, see margin_for.
+  template <typename VisitCell, typename StopAfterSlab>
+  void visit_cells_on_line(const double start[2], const double direction[2], double t_begin, double t_end, double margin, VisitCell visit_cell, StopAfterSlab stop_after_slab)
+  {
+    const int a = std::abs(direction[0]) >= std::abs(direction[1]) ? 0 : 1, b = 1 - a;
+    const auto cell_at = [this, a](int i_a, int i_b) { return a == 0 ? i_b * cells_per_axis + i_a : i_a * cells_per_axis + i_b; };
 
-  auto inspect_hit_point = [&did_intersect, &closest_intersection, &ray_origin](const K::Point_2 &hit_point) {
-    if (!did_intersect || CGAL::has_smaller_distance_to_point(ray_origin, hit_point, closest_intersection))
+    if (direction[a] == 0)
     {
-      if (debug_level >= 2)
+      int first_a, last_a, first_b, last_b;
+      if (cell_range(a, start[a], start[a], margin, first_a, last_a) && cell_range(b, start[b], start[b], margin, first_b, last_b))
       {
-        std::cout << "closer\n";
+        for (int i_a = first_a; i_a <= last_a; i_a++)
+        {
+          for (int i_b = first_b; i_b <= last_b; i_b++)
+          {
+            visit_cell(cell_at(i_a, i_b));
+          }
+        }
       }
-      closest_intersection = hit_point;
-      did_intersect = true;
+      return;
     }
-  };
 
-  for (auto wall : walls)
-  {
-    K::Segment_2 ray_segment(ray_origin, closest_intersection);
-    if (!(did_intersect ? CGAL::do_intersect(ray_segment, wall) : CGAL::do_intersect(ray, wall)))
+    const double slope = direction[b] / direction[a];
+    const auto b_at = [start, a, b, slope](double coordinate_a) { return start[b] + (coordinate_a - start[a]) * slope; };
+
+    double line_from = start[a] + t_begin * direction[a];
+    double line_to = std::isinf(t_end) ? (direction[a] > 0 ? bounds_max[a] + margin : bounds_min[a] - margin) : start[a] + t_end * direction[a];
+    if (line_from > line_to)
     {
-      continue;
+      std::swap(line_from, line_to);
+    }
+    line_from = std::max(line_from, bounds_min[a] - margin);
+    line_to = std::min(line_to, bounds_max[a] + margin);
+    int first_a, last_a;
+    if (line_from > line_to || !cell_range(a, line_from, line_to, margin, first_a, last_a))
+    {
+      return;
     }
 
-    auto generic_intersection = did_intersect ? CGAL::intersection(ray_segment, wall) : CGAL::intersection(ray, wall);
-    if (const K::Point_2 *hit_point = boost::get<K::Point_2>(&*generic_intersection))
+    const int step = direction[a] > 0 ? 1 : -1;
+    const int begin_a = step > 0 ? first_a : last_a, end_a = step > 0 ? last_a + 1 : first_a - 1;
+    for (int i_a = begin_a; i_a != end_a; i_a += step)
     {
-      if (debug_level >= 2)
+      const double slab_from = bounds_min[a] + i_a * cell_size[a], slab_to = slab_from + cell_size[a];
+      const double from_a = std::max(slab_from - margin, line_from), to_a = std::min(slab_to + margin, line_to);
+      const double b_from = b_at(from_a), b_to = b_at(to_a);
+      int first_b, last_b;
+      if (from_a <= to_a && cell_range(b, std::min(b_from, b_to), std::max(b_from, b_to), margin, first_b, last_b))
       {
-        std::cout << "hit point " << *hit_point << "\n";
+        for (int i_b = first_b; i_b <= last_b; i_b++)
+        {
+          visit_cell(cell_at(i_a, i_b));
+        }
       }
-      inspect_hit_point(*hit_point);
-    }
-    else if (const K::Segment_2 *hit_segment = boost::get<K::Segment_2>(&*generic_intersection))
-    {
-      if (debug_level >= 2)
+      if (stop_after_slab(step > 0 ? slab_to : slab_from))
       {
-        std::cout << "hit segment " << *hit_segment << "\n";
+        return;
       }
-      inspect_hit_point(hit_segment->source());
-      inspect_hit_point(hit_segment->target());
-    }
-    else
-    {
-      assert(false);
     }
   }
 
+  const std::vector<K::Segment_2> &walls;
+  std::vector<int> last_query_by_wall;
+  int num_queries;
+  double bounds_min[2], bounds_max[2], cell_size[2], max_abs_coordinate, wall_margin;
+  int cells_per_axis;
+  std::vector<int> cell_offsets, cell_walls;
+};
+
+bool testcase()
+{
+  int n = input.read_int();
+  if (n == 0)
+  {
+    return false;
+  }
+  assert(n >= 1 && n <= 30'000);
+
+  double x = input.read_double(), y = input.read_double(), a = input.read_double(), b = input.read_double();
+  K::Point_2 ray_origin(x, y);
+  K::Ray_2 ray(ray_origin, K::Point_2(a, b));
+
+  std::vector<K::Segment_2> walls;
+  for (int i = 0; i < n; i++)
+  {
+    double r = input.read_double(), s = input.read_double(), t = input.read_double(), u = input.read_double();
+    K::Segment_2 wall(K::Point_2(r, s), K::Point_2(t, u));
+    walls.push_back(wall);
+  }
+
+  WallGrid wall_grid(walls);
+  K::Point_2 closest_intersection;
+  bool did_intersect = wall_grid.find_first_hit(ray, closest_intersection);
+
   if (did_intersect)
   {
-    std::cout << long(floor_to_double(closest_intersection.x())) << " " << long(floor_to_double(closest_intersection.y())) << "\n";
+    output.write_long(long(floor_to_double(closest_intersection.x())));
+    output.write_char(' ');
+    output.write_long(long(floor_to_double(closest_intersection.y())));
+    output.write_char('\n');
   }
   else
   {
-    std::cout << "no\n";
+    output.write_string("no\n");
   }
   return true;
 }
@@ -109,11 +646,14 @@ int main()
 {
   std::ios_base::sync_with_stdio(false);
 
-  std::srand(0);
-
   while (testcase())
   {
   };
 
+  if (debug_level >= 1)
+  {
+    print_filter_stats();
+  }
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+const child_process = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+const COMPILED_ALGORITHM_PATH = "../a"; // relative to this JS file
+
+function randomInt(min, max) {
+  return min + Math.floor(Math.random() * (max - min + 1));
+}
+
+// triangleToString describes the triangle with corners a, b, c (counter-clockwise,
+// all coordinates divisible by 3) by two points on each of its sides.
+function triangleToString(a, b, c) {
+  const points = [];
+  for (const [p, q] of [
+    [a, b],
+    [b, c],
+    [c, a],
+  ]) {
+    points.push([(2 * p[0] + q[0]) / 3, (2 * p[1] + q[1]) / 3]);
+    points.push([(p[0] + 2 * q[0]) / 3, (p[1] + 2 * q[1]) / 3]);
+  }
+  return points.map((p) => `${p[0]} ${p[1]}`).join(" ");
+}
+
+function genRandomTriangle(r) {
+  while (true) {
+    const [a, b, c] = [0, 1, 2].map(() => [
+      3 * randomInt(-2 * r, 2 * r),
+      3 * randomInt(-2 * r, 2 * r),
+    ]);
+    const det = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+    if (det > 0) {
+      return triangleToString(a, b, c);
+    } else if (det < 0) {
+      return triangleToString(a, c, b);
+    }
+  }
+}
+
+// genCoveringTriangle returns a triangle which contains both p and q
+function genCoveringTriangle(p, q) {
+  const x = 3 * Math.floor((Math.min(p[0], q[0]) - 3) / 3);
+  const y = 3 * Math.floor((Math.min(p[1], q[1]) - 3) / 3);
+  const w = 3 * (Math.abs(p[0] - q[0]) + Math.abs(p[1] - q[1]) + 6);
+  return triangleToString([x, y], [x + 2 * w, y], [x, y + 2 * w]);
+}
+
+function genRandomInput(c, m, n) {
+  const r = 1000;
+  const lines = [`${c}`];
+  for (let i = 0; i < c; i++) {
+    lines.push(`${m} ${n}`);
+    const pathPoints = [];
+    for (let j = 0; j < m; j++) {
+      pathPoints.push([randomInt(-r, r), randomInt(-r, r)]);
+      lines.push(`${pathPoints[j][0]} ${pathPoints[j][1]}`);
+    }
+    // every (n / (m - 1))th triangle covers the next path segment, so there is always a solution
+    let nextSegment = 0;
+    for (let j = 0; j < n; j++) {
+      if (nextSegment < m - 1 && j % Math.floor(n / (m - 1)) === 0) {
+        lines.push(
+          genCoveringTriangle(pathPoints[nextSegment], pathPoints[nextSegment + 1])
+        );
+        nextSegment++;
+      } else {
+        lines.push(genRandomTriangle(r));
+      }
+    }
+  }
+  return lines.join("\n") + "\n";
+}
+
+function timeAlgorithm(numThreads, inputPath) {
+  const start = process.hrtime.bigint();
+  child_process.execSync(
+    `${path
+      .join(__dirname, COMPILED_ALGORITHM_PATH)
+      .replace(/ /g, "\\ ")} < ${inputPath}`,
+    {
+      stdio: ["ignore", "ignore", "inherit"],
+      env: { ...process.env, NUM_THREADS: `${numThreads}` },
+    }
+  );
+  return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+function bench(c, m, n) {
+  const inputPath = path.join(os.tmpdir(), `hiking-maps-bench-${c}-${m}-${n}.txt`);
+  fs.writeFileSync(inputPath, genRandomInput(c, m, n));
+  let singleThreadTime;
+  for (let numThreads = 1; numThreads <= os.cpus().length; numThreads *= 2) {
+    const time = timeAlgorithm(numThreads, inputPath);
+    singleThreadTime = singleThreadTime || time;
+    console.log(
+      `c = ${c}, m = ${m}, n = ${n}, threads = ${numThreads}: ${time.toFixed(
+        1
+      )} ms (speedup ${(singleThreadTime / time).toFixed(2)})`
+    );
+  }
+  fs.unlinkSync(inputPath);
+}
+
+bench(60, 2000, 2000);
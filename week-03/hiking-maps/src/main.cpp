@@ -3,6 +3,17 @@
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <vector>
 #include <array>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 const int debug_level = 1;
 
@@ -11,6 +22,335 @@ const int triangle_size = 6;
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 typedef std::array<K::Point_2, triangle_size> Triangle;
 
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+// A reader can also be created for a byte range of another reader's input.
+class InputReader
+{
+public:
+  InputReader(const char *begin, const char *end) : pos(begin), end(end) {}
+
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
+
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
+
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
+
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
+
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
+  }
+
+  void skip_tokens(long num_tokens)
+  {
+    for (long i = 0; i < num_tokens; i++)
+    {
+      skip_whitespace();
+      while (pos < end && *pos > ' ')
+      {
+        pos++;
+      }
+    }
+  }
+
+  const char *position() const
+  {
+    return pos;
+  }
+
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
+  }
+
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+// With fd -1 the writer never flushes, it only collects output for append_to.
+class OutputWriter
+{
+public:
+  explicit OutputWriter(int fd = STDOUT_FILENO) : buffer(fd >= 0 ? 1 << 20 : 1 << 10), size(0), fd(fd) {}
+
+  ~OutputWriter()
+  {
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
+    {
+      write_char(*s++);
+    }
+  }
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void append_to(OutputWriter &other) const
+  {
+    for (size_t i = 0; i < size; i++)
+    {
+      other.write_char(buffer[i]);
+    }
+  }
+
+  void flush()
+  {
+    if (fd < 0)
+    {
+      return;
+    }
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(fd, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      if (fd >= 0)
+      {
+        flush();
+      }
+      else
+      {
+        buffer.resize(std::max(2 * buffer.size(), size + needed));
+      }
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+  int fd;
+};
+
+// run_testcases_in_parallel first splits the input into one byte range per test case,
+// using skip_testcase to find where each one ends. Threads then repeatedly claim the
+// next unstarted test case, so a few large test cases don't leave the other threads
+// idle. Every test case writes into its own buffer and the buffers are printed in
+// input order. The thread count is NUM_THREADS if set, otherwise one per core.
+template <typename SkipTestcase, typename Testcase>
+void run_testcases_in_parallel(InputReader &input, OutputWriter &output, int num_testcases, SkipTestcase skip_testcase, Testcase testcase)
+{
+  std::vector<std::pair<const char *, const char *>> testcase_ranges;
+  for (int i = 0; i < num_testcases; i++)
+  {
+    const char *begin = input.position();
+    skip_testcase(input);
+    testcase_ranges.emplace_back(begin, input.position());
+  }
+
+  std::vector<OutputWriter> testcase_outputs;
+  testcase_outputs.reserve(num_testcases);
+  for (int i = 0; i < num_testcases; i++)
+  {
+    testcase_outputs.emplace_back(-1);
+  }
+
+  int num_threads = std::thread::hardware_concurrency();
+  if (const char *num_threads_env = std::getenv("NUM_THREADS"))
+  {
+    num_threads = std::atoi(num_threads_env);
+  }
+  num_threads = std::max(1, std::min(num_threads, num_testcases));
+
+  std::atomic<int> next_testcase(0);
+  const auto run_worker = [&]() {
+    while (true)
+    {
+      int i = next_testcase++;
+      if (i >= num_testcases)
+      {
+        return;
+      }
+      InputReader testcase_input(testcase_ranges.at(i).first, testcase_ranges.at(i).second);
+      testcase(testcase_input, testcase_outputs.at(i));
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_threads; i++)
+  {
+    threads.emplace_back(run_worker);
+  }
+  run_worker();
+  for (std::thread &thread : threads)
+  {
+    thread.join();
+  }
+
+  for (const OutputWriter &testcase_output : testcase_outputs)
+  {
+    testcase_output.append_to(output);
+  }
+}
+
 // orient_triangle reorders the points that define a triangle
 // so that all points in sequence describe a counter-clockwise
 // convex polygon.
@@ -47,7 +387,7 @@ void orient_triangle(Triangle &triangle, bool assert_already_oriented = false)
   {
     if (debug_level >= 2)
     {
-      std::cout << "did_reorient " << did_reorient << "\n";
+      std::cerr << "did_reorient " << did_reorient << "\n";
     }
     if (debug_level >= 1)
     {
@@ -56,35 +396,91 @@ void orient_triangle(Triangle &triangle, bool assert_already_oriented = false)
   }
 }
 
-bool is_outside_triangle(const Triangle &triangle, const K::Point_2 &p)
+const int word_bits = 64;
+
+// PathPoints stores the path as a structure of arrays, so that testing many points
+// against one triangle is a straight loop which the compiler can vectorize.
+struct PathPoints
+{
+  std::vector<int> xs, ys;
+};
+
+// mark_segments_in_triangle sets bit i of segment_words iff the path segment from
+// point i to point i + 1 is contained in the triangle. All coordinates are ints with
+// absolute value below 2^30, so coordinate differences fit into an int, their products
+// fit into a long, and the test is exact.
+void mark_segments_in_triangle(const Triangle &triangle, const PathPoints &points, uint64_t *segment_words)
 {
+  const int m = points.xs.size();
+  const int num_point_words = (m + word_bits - 1) / word_bits;
+
+  int edge_xs[triangle_size], edge_ys[triangle_size];
+  for (int i = 0; i < triangle_size; i++)
+  {
+    edge_xs[i] = int(triangle.at(i).x());
+    edge_ys[i] = int(triangle.at(i).y());
+  }
+  int dxs[triangle_size / 2], dys[triangle_size / 2];
   for (int i = 0; i < triangle_size; i += 2)
   {
-    if (CGAL::right_turn(triangle.at(i), triangle.at(i + 1), p))
+    dxs[i / 2] = edge_xs[i + 1] - edge_xs[i];
+    dys[i / 2] = edge_ys[i + 1] - edge_ys[i];
+  }
+
+  std::vector<uint64_t> point_words(num_point_words, 0);
+  for (int i_word = 0; i_word < num_point_words; i_word++)
+  {
+    const int begin = i_word * word_bits, count = std::min(word_bits, m - begin);
+    const int *xs = points.xs.data() + begin, *ys = points.ys.data() + begin;
+    uint8_t inside[word_bits];
+    for (int k = 0; k < count; k++)
     {
-      return true;
+      const long orientation_0 = long(dxs[0]) * (ys[k] - edge_ys[0]) - long(dys[0]) * (xs[k] - edge_xs[0]);
+      const long orientation_1 = long(dxs[1]) * (ys[k] - edge_ys[2]) - long(dys[1]) * (xs[k] - edge_xs[2]);
+      const long orientation_2 = long(dxs[2]) * (ys[k] - edge_ys[4]) - long(dys[2]) * (xs[k] - edge_xs[4]);
+      inside[k] = (orientation_0 >= 0) & (orientation_1 >= 0) & (orientation_2 >= 0);
     }
+    uint64_t word = 0;
+    for (int k = 0; k < count; k++)
+    {
+      word |= uint64_t(inside[k]) << k;
+    }
+    point_words.at(i_word) = word;
+  }
+
+  const int num_segment_words = (m - 1 + word_bits - 1) / word_bits;
+  for (int i_word = 0; i_word < num_segment_words; i_word++)
+  {
+    const uint64_t next_points = i_word + 1 < num_point_words ? point_words.at(i_word + 1) << (word_bits - 1) : 0;
+    segment_words[i_word] = point_words.at(i_word) & ((point_words.at(i_word) >> 1) | next_points);
+  }
+  if ((m - 1) % word_bits != 0)
+  {
+    segment_words[num_segment_words - 1] &= (uint64_t(1) << ((m - 1) % word_bits)) - 1;
   }
-  return false;
 }
 
-void testcase()
+void testcase(InputReader &input, OutputWriter &output)
 {
   // - determine which segments are contained in which triangles
   // - use sliding window to find shortest window
   //   - track number of triangles that each line is contained in
 
-  int m, n;
-  std::cin >> m >> n;
+  int m = input.read_int(), n = input.read_int();
   assert(m >= 2 && m <= 2000);
   assert(n >= 2 && n <= 2000);
 
-  std::vector<K::Point_2> path_points;
+  const auto read_coordinate = [&input]() {
+    int v = input.read_int();
+    assert(std::abs(v) < (1 << 30));
+    return v;
+  };
+
+  PathPoints path_points;
   for (int i_point = 0; i_point < m; i_point++)
   {
-    int x, y;
-    std::cin >> x >> y;
-    path_points.push_back(K::Point_2(x, y));
+    path_points.xs.push_back(read_coordinate());
+    path_points.ys.push_back(read_coordinate());
   }
 
   std::vector<Triangle> triangles(n);
@@ -93,26 +489,34 @@ void testcase()
     Triangle &triangle = triangles.at(i_triangle);
     for (int i_point = 0; i_point < triangle_size; i_point++)
     {
-      int x, y;
-      std::cin >> x >> y;
+      int x = read_coordinate(), y = read_coordinate();
       triangle.at(i_point) = K::Point_2(x, y);
     }
     orient_triangle(triangle);
   }
 
-  std::vector<std::vector<int>> segments_by_triangle(n);
+  const int num_segment_words = (m - 1 + word_bits - 1) / word_bits;
+  std::vector<uint64_t> segment_words_by_triangle(n * num_segment_words);
   for (int i_triangle = 0; i_triangle < n; i_triangle++)
   {
-    Triangle &triangle = triangles.at(i_triangle);
-    std::vector<int> &segments = segments_by_triangle.at(i_triangle);
-    for (int i_segment = 0; i_segment < m - 1; i_segment++)
+    mark_segments_in_triangle(triangles.at(i_triangle), path_points, &segment_words_by_triangle.at(i_triangle * num_segment_words));
+  }
+
+  // for_each_segment calls f for every segment contained in the triangle,
+  // until f returns false
+  const auto for_each_segment = [num_segment_words, &segment_words_by_triangle](int i_triangle, auto f) {
+    const uint64_t *segment_words = &segment_words_by_triangle.at(i_triangle * num_segment_words);
+    for (int i_word = 0; i_word < num_segment_words; i_word++)
     {
-      if (!is_outside_triangle(triangle, path_points.at(i_segment)) && !is_outside_triangle(triangle, path_points.at(i_segment + 1)))
+      for (uint64_t bits = segment_words[i_word]; bits != 0; bits &= bits - 1)
       {
-        segments.push_back(i_segment);
+        if (!f(i_word * word_bits + __builtin_ctzll(bits)))
+        {
+          return;
+        }
       }
     }
-  }
+  };
 
   int i_start = 0, i_end = 0;
   std::vector<int> times_covered_by_segment(m - 1, 0);
@@ -122,8 +526,7 @@ void testcase()
   {
     assert(i_start >= 0 && i_start <= i_end);
 
-    for (int i_segment : segments_by_triangle.at(i_end))
-    {
+    for_each_segment(i_end, [&](int i_segment) {
       int &times_covered = times_covered_by_segment.at(i_segment);
       if (times_covered == 0)
       {
@@ -131,32 +534,29 @@ void testcase()
         assert(covered_segments <= m - 1);
       }
       times_covered++;
-    }
+      return true;
+    });
     i_end++;
 
     while (i_start < i_end)
     {
       bool all_redundant = true;
-      for (int i_segment : segments_by_triangle.at(i_start))
-      {
+      for_each_segment(i_start, [&](int i_segment) {
         int times_covered = times_covered_by_segment.at(i_segment);
         assert(times_covered >= 1);
-        if (times_covered == 1)
-        {
-          all_redundant = false;
-          break;
-        }
-      }
+        all_redundant = times_covered > 1;
+        return all_redundant;
+      });
 
       if (!all_redundant)
       {
         break;
       }
 
-      for (int i_segment : segments_by_triangle.at(i_start))
-      {
+      for_each_segment(i_start, [&](int i_segment) {
         times_covered_by_segment.at(i_segment)--;
-      }
+        return true;
+      });
       i_start++;
     }
 
@@ -170,20 +570,22 @@ void testcase()
     }
   }
   assert(min_cost != std::numeric_limits<int>::max());
-  std::cout << min_cost << "\n";
+  output.write_int(min_cost);
+  output.write_char('\n');
 }
 
 int main()
 {
-  std::ios_base::sync_with_stdio(false);
+  InputReader input;
+  OutputWriter output;
 
-  int c;
-  std::cin >> c;
+  int c = input.read_int();
   assert(c >= 0 && c <= 60);
-  for (int i = 0; i < c; i++)
-  {
-    testcase();
-  }
+  const auto skip_testcase = [](InputReader &input) {
+    int m = input.read_int(), n = input.read_int();
+    input.skip_tokens(2 * m + 2 * triangle_size * n);
+  };
+  run_testcases_in_parallel(input, output, c, skip_testcase, testcase);
 
   return 0;
 }
\ No newline at end of file
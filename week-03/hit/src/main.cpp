@@ -1,21 +1,335 @@
 #include <iostream>
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <limits>
+#include <string>
+#include <cmath>
+#include <vector>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 
+const int debug_level = 0;
+
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
+{
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
+
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
+
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
+
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
+
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
+  }
+
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
+  }
+
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
+{
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
+  {
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
+    {
+      write_char(*s++);
+    }
+  }
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
+// The filtered predicates below decide with plain doubles whenever the rounding error
+// provably can't change the answer, and report filter_unsure otherwise so that the
+// caller falls back to the exact kernel. The error bound is the one from Shewchuk's
+// "Adaptive Precision Floating-Point Arithmetic" for 2D orientation, which also holds
+// for any (b - a) x (d - c) with double inputs.
+enum FilterResult
+{
+  filter_no,
+  filter_yes,
+  filter_unsure
+};
+
+struct FilterStats
+{
+  long bbox_rejects = 0, filter_rejects = 0, filter_accepts = 0, exact_fallbacks = 0;
+};
+
+FilterStats filter_stats;
+
+// filtered_cross_sign returns the sign of (b - a) x (d - c), or 0 if it's uncertain
+inline int filtered_cross_sign(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy)
+{
+  const double error_bound_factor = 3.3306690738754716e-16;
+  const double left = (bx - ax) * (dy - cy), right = (by - ay) * (dx - cx);
+  const double det = left - right, error_bound = error_bound_factor * (std::abs(left) + std::abs(right));
+  if (det > error_bound)
+  {
+    return 1;
+  }
+  if (-det > error_bound)
+  {
+    return -1;
+  }
+  return 0;
+}
+
+// filtered_ray_hits_segment decides whether the ray from o through t hits the segment pq
+FilterResult filtered_ray_hits_segment(double ox, double oy, double tx, double ty, double px, double py, double qx, double qy)
+{
+  if ((tx > ox && std::max(px, qx) < ox) || (tx < ox && std::min(px, qx) > ox) || (ty > oy && std::max(py, qy) < oy) || (ty < oy && std::min(py, qy) > oy))
+  {
+    filter_stats.bbox_rejects++;
+    return filter_no;
+  }
+
+  // p and q strictly on the same side of the ray's line
+  const int p_side = filtered_cross_sign(ox, oy, tx, ty, ox, oy, px, py), q_side = filtered_cross_sign(ox, oy, tx, ty, ox, oy, qx, qy);
+  if (p_side != 0 && p_side == q_side)
+  {
+    filter_stats.filter_rejects++;
+    return filter_no;
+  }
+
+  // the segment's line is crossed ahead of o if moving along the ray brings o closer to it
+  const int o_side = filtered_cross_sign(px, py, qx, qy, px, py, ox, oy), ray_side = filtered_cross_sign(px, py, qx, qy, ox, oy, tx, ty);
+  if (p_side != 0 && q_side != 0 && o_side != 0 && ray_side != 0)
+  {
+    if (o_side != ray_side)
+    {
+      filter_stats.filter_accepts++;
+      return filter_yes;
+    }
+    filter_stats.filter_rejects++;
+    return filter_no;
+  }
+
+  filter_stats.exact_fallbacks++;
+  return filter_unsure;
+}
+
+void print_filter_stats()
+{
+  std::cerr << "bbox_rejects " << filter_stats.bbox_rejects << " filter_rejects " << filter_stats.filter_rejects
+            << " filter_accepts " << filter_stats.filter_accepts << " exact_fallbacks " << filter_stats.exact_fallbacks << "\n";
+}
+
 bool testcase()
 {
-  int n;
-  std::cin >> n;
+  int n = input.read_int();
   if (n == 0)
   {
     return false;
   }
   assert(n >= 1 && n <= 20'000);
 
-  double x, y, a, b;
-  std::cin >> x >> y >> a >> b;
+  double x = input.read_double(), y = input.read_double(), a = input.read_double(), b = input.read_double();
   K::Ray_2 ray(K::Point_2(x, y), K::Point_2(a, b));
 
   bool did_intersect = false;
@@ -23,22 +337,21 @@ bool testcase()
   {
     if (did_intersect)
     {
-      std::cin.ignore(std::numeric_limits<long>::max(), '\n');
+      input.skip_line();
     }
     else
     {
-      double r, s, t, u;
-      std::cin >> r >> s >> t >> u;
-      K::Segment_2 segment(K::Point_2(r, s), K::Point_2(t, u));
-      if (CGAL::do_intersect(ray, segment))
+      double r = input.read_double(), s = input.read_double(), t = input.read_double(), u = input.read_double();
+      FilterResult filter_result = filtered_ray_hits_segment(x, y, a, b, r, s, t, u);
+      if (filter_result == filter_yes || (filter_result == filter_unsure && CGAL::do_intersect(ray, K::Segment_2(K::Point_2(r, s), K::Point_2(t, u)))))
       {
         did_intersect = true;
-        std::cin >> std::ws;
+        input.skip_line();
       }
     }
   }
 
-  std::cout << (did_intersect ? "yes\n" : "no\n");
+  output.write_string(did_intersect ? "yes\n" : "no\n");
   return true;
 }
 
@@ -50,5 +363,10 @@ int main()
   {
   };
 
+  if (debug_level >= 1)
+  {
+    print_filter_stats();
+  }
+
   return 0;
 }
\ No newline at end of file
@@ -1,85 +1,387 @@
 #include <iostream>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/graph/prim_minimum_spanning_tree.hpp>
 #include <limits>
 #include <cassert>
-#include <map>
+#include <algorithm>
+#include <string>
+#include <cmath>
+#include <vector>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, boost::no_property, boost::property<boost::edge_weight_t, int>> Graph;
+const int infinite_weight = std::numeric_limits<int>::max();
 
-void testcase()
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
 {
-  int n, e, s, source_node, target_node;
-  std::cin >> n >> e >> s >> source_node >> target_node;
-  assert(n >= 1 && n <= 500 && e >= 1 && s >= 1 && s <= 10);
-  assert(source_node >= 0 && source_node < n);
-  assert(target_node >= 0 && target_node < n);
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
 
-  Graph G(n);
-  auto shared_weights = boost::get(boost::edge_weight, G);
-  int infinite_weight = std::numeric_limits<int>::max();
-  std::vector<std::map<Graph::edge_descriptor, int>> weights_by_species(s);
-  for (int i = 0; i < e; i++)
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
   {
-    int a, b;
-    std::cin >> a >> b;
-    Graph::edge_descriptor edge = boost::add_edge(a, b, infinite_weight, G).first;
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
 
-    for (int j = 0; j < s; j++)
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
+
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
+
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
+  }
+
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
+  }
+
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
+{
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
+  {
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
     {
-      int w;
-      std::cin >> w;
-      weights_by_species.at(j).insert(std::make_pair(edge, w));
+      write_char(*s++);
     }
   }
 
-  for (int i = 0; i < s; i++)
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
+// Adjacency stores the undirected graph in compressed sparse row form. The neighbors
+// of node a are targets[offsets[a]..offsets[a + 1]), and edge_indices holds the index
+// (in input order) of the edge leading to each of them, so that any per-edge array
+// can be used as a weight map without building a new graph.
+struct Adjacency
+{
+  std::vector<int> offsets, targets, edge_indices;
+};
+
+Adjacency build_adjacency(int n, const std::vector<int> &edge_ends)
+{
+  int e = edge_ends.size() / 2;
+  Adjacency adjacency;
+  adjacency.offsets.assign(n + 1, 0);
+  for (int i = 0; i < 2 * e; i++)
+  {
+    adjacency.offsets.at(edge_ends.at(i) + 1)++;
+  }
+  for (int a = 0; a < n; a++)
+  {
+    adjacency.offsets.at(a + 1) += adjacency.offsets.at(a);
+  }
+  adjacency.targets.resize(2 * e);
+  adjacency.edge_indices.resize(2 * e);
+  std::vector<int> next_slot(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+  for (int i = 0; i < e; i++)
+  {
+    int a = edge_ends.at(2 * i), b = edge_ends.at(2 * i + 1);
+    adjacency.targets.at(next_slot.at(a)) = b;
+    adjacency.edge_indices.at(next_slot.at(a)++) = i;
+    adjacency.targets.at(next_slot.at(b)) = a;
+    adjacency.edge_indices.at(next_slot.at(b)++) = i;
+  }
+  return adjacency;
+}
+
+// visit_closest_first runs the shared part of Prim and Dijkstra from root: it
+// repeatedly settles the unsettled node with the smallest key and relaxes its edges
+// with key_through(key of settled node, edge index). With n <= 500 and dense graphs,
+// scanning all keys is cheaper than a heap. on_settle(node, edge index) is called for
+// every reached node except the root, with the edge it was reached through.
+template <typename KeyThrough, typename OnSettle>
+std::vector<int> visit_closest_first(const Adjacency &adjacency, int root, KeyThrough key_through, OnSettle on_settle)
+{
+  int n = adjacency.offsets.size() - 1;
+  std::vector<int> keys(n, infinite_weight), reached_by(n, -1);
+  std::vector<bool> settled(n, false);
+  keys.at(root) = 0;
+  for (int i = 0; i < n; i++)
   {
-    int hive_location;
-    std::cin >> hive_location;
-    auto species_weight_map = boost::make_assoc_property_map(weights_by_species.at(i));
-    std::vector<Graph::vertex_descriptor> predecessors(n);
-    boost::prim_minimum_spanning_tree(G, boost::make_iterator_property_map(predecessors.begin(), boost::get(boost::vertex_index, G)), boost::weight_map(species_weight_map).root_vertex(hive_location));
+    int a = -1;
+    for (int b = 0; b < n; b++)
+    {
+      if (!settled[b] && keys[b] != infinite_weight && (a == -1 || keys[b] < keys[a]))
+      {
+        a = b;
+      }
+    }
+    if (a == -1)
+    {
+      break;
+    }
+    settled[a] = true;
+    if (a != root)
+    {
+      on_settle(a, reached_by[a]);
+    }
 
-    for (Graph::vertex_descriptor a = 0; a < Graph::vertex_descriptor(n); a++)
+    for (int j = adjacency.offsets[a]; j < adjacency.offsets[a + 1]; j++)
     {
-      Graph::vertex_descriptor b = predecessors.at(a);
-      if (a == b)
+      int b = adjacency.targets[j], edge = adjacency.edge_indices[j];
+      if (settled[b])
       {
         continue;
       }
-      assert(boost::edge(a, b, G).second);
-      Graph::edge_descriptor edge = boost::edge(a, b, G).first;
-      int &min_weight = shared_weights[edge];
-      min_weight = std::min({min_weight, species_weight_map[edge]});
+      int key = key_through(keys[a], edge);
+      if (key < keys[b])
+      {
+        keys[b] = key;
+        reached_by[b] = edge;
+      }
     }
   }
+  return keys;
+}
+
+void testcase()
+{
+  int n = input.read_int(), e = input.read_int(), s = input.read_int(), source_node = input.read_int(), target_node = input.read_int();
+  assert(n >= 1 && n <= 500 && e >= 1 && s >= 1 && s <= 10);
+  assert(source_node >= 0 && source_node < n);
+  assert(target_node >= 0 && target_node < n);
 
-  Graph G_finite(n);
-  for (auto edge_iterators = boost::edges(G); edge_iterators.first != edge_iterators.second; edge_iterators.first++)
+  // weights_by_species[j * e + i] is the weight of edge i for species j
+  std::vector<int> edge_ends(2 * e), weights_by_species(s * e);
+  for (int i = 0; i < e; i++)
   {
-    auto edge = *edge_iterators.first;
-    int w = shared_weights[edge];
-    assert(w >= 0);
-    if (w != infinite_weight)
+    edge_ends.at(2 * i) = input.read_int();
+    edge_ends.at(2 * i + 1) = input.read_int();
+    assert(edge_ends.at(2 * i) >= 0 && edge_ends.at(2 * i) < n);
+    assert(edge_ends.at(2 * i + 1) >= 0 && edge_ends.at(2 * i + 1) < n);
+
+    for (int j = 0; j < s; j++)
     {
-      boost::add_edge(edge.m_source, edge.m_target, w, G_finite);
+      int w = input.read_int();
+      assert(w >= 0);
+      weights_by_species.at(j * e + i) = w;
     }
   }
+  Adjacency adjacency = build_adjacency(n, edge_ends);
+
+  // min_weights[i] is the smallest weight of edge i among the species whose
+  // network contains it, or infinite_weight if no network contains it
+  std::vector<int> min_weights(e, infinite_weight);
+  for (int j = 0; j < s; j++)
+  {
+    int hive_location = input.read_int();
+    assert(hive_location >= 0 && hive_location < n);
+    const int *species_weights = weights_by_species.data() + j * e;
+    visit_closest_first(
+        adjacency, hive_location,
+        [&](int, int edge) { return species_weights[edge]; },
+        [&](int, int edge) { min_weights[edge] = std::min(min_weights[edge], species_weights[edge]); });
+  }
 
-  std::vector<int> distances(n);
-  boost::dijkstra_shortest_paths(G_finite, boost::vertex(source_node, G_finite), boost::distance_map(boost::make_iterator_property_map(distances.begin(), boost::get(boost::vertex_index, G_finite))));
+  std::vector<int> distances = visit_closest_first(
+      adjacency, source_node,
+      [&](int distance, int edge) { return min_weights[edge] == infinite_weight ? infinite_weight : distance + min_weights[edge]; },
+      [](int, int) {});
 
-  std::cout << distances.at(target_node) << "\n";
+  output.write_int(distances.at(target_node));
+  output.write_char('\n');
 }
 
 int main()
 {
   std::ios_base::sync_with_stdio(false);
 
-  int t;
-  std::cin >> t;
+  int t = input.read_int();
   for (int i = 0; i < t; i++)
   {
     testcase();
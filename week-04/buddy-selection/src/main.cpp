@@ -1,12 +1,128 @@
 #include <iostream>
 #include <vector>
 #include <cassert>
-#include <map>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/max_cardinality_matching.hpp>
 
 typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
 
+const int word_bits = 64;
+
+// for_each_row_in_parallel calls process_row(i) for every i in [0, num_rows). Rows
+// are claimed one at a time from a shared counter, since in a triangular pair loop
+// the early rows are much more expensive than the late ones. The thread count is
+// NUM_THREADS if set, otherwise one per core.
+template <typename ProcessRow>
+void for_each_row_in_parallel(int num_rows, ProcessRow process_row)
+{
+  int num_threads = std::thread::hardware_concurrency();
+  if (const char *num_threads_env = std::getenv("NUM_THREADS"))
+  {
+    num_threads = std::atoi(num_threads_env);
+  }
+  num_threads = std::max(1, std::min(num_threads, num_rows / 32));
+
+  std::atomic<int> next_row(0);
+  const auto run_worker = [&]() {
+    while (true)
+    {
+      int i = next_row++;
+      if (i >= num_rows)
+      {
+        return;
+      }
+      process_row(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_threads; i++)
+  {
+    threads.emplace_back(run_worker);
+  }
+  run_worker();
+  for (std::thread &thread : threads)
+  {
+    thread.join();
+  }
+}
+
+// has_odd_component returns true if some connected component of G has an odd number
+// of vertices. Such a graph can not have a perfect matching.
+bool has_odd_component(const Graph &G)
+{
+  int n = boost::num_vertices(G);
+  std::vector<int> component(n, -1), stack;
+  for (int root = 0; root < n; root++)
+  {
+    if (component.at(root) != -1)
+    {
+      continue;
+    }
+    int component_size = 0;
+    component.at(root) = root;
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+      int a = stack.back();
+      stack.pop_back();
+      component_size++;
+      for (auto its = boost::adjacent_vertices(a, G); its.first != its.second; its.first++)
+      {
+        int b = *its.first;
+        if (component.at(b) == -1)
+        {
+          component.at(b) = root;
+          stack.push_back(b);
+        }
+      }
+    }
+    if (component_size % 2 == 1)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// has_perfect_matching first tries the cheap exits: an odd component (which includes
+// isolated students) rules out a perfect matching, and a perfect greedy matching
+// needs no augmenting at all. Only otherwise Edmonds' algorithm augments the greedy
+// matching until it is perfect or no augmenting path is left.
+bool has_perfect_matching(const Graph &G)
+{
+  int n = boost::num_vertices(G);
+  if (has_odd_component(G))
+  {
+    return false;
+  }
+
+  std::vector<Graph::vertex_descriptor> mate(n);
+  boost::extra_greedy_matching<Graph, Graph::vertex_descriptor *>::find_matching(G, &mate[0]);
+  const auto count_matched = [&]() {
+    return std::count_if(mate.begin(), mate.end(), [](Graph::vertex_descriptor v) { return v != Graph::null_vertex(); });
+  };
+  int num_matched = count_matched();
+  if (num_matched == n)
+  {
+    return true;
+  }
+
+  boost::edmonds_augmenting_path_finder<Graph, Graph::vertex_descriptor *, boost::property_map<Graph, boost::vertex_index_t>::type> augmentor(G, &mate[0], boost::get(boost::vertex_index, G));
+  while (num_matched < n && augmentor.augment_matching())
+  {
+    num_matched += 2;
+  }
+  return num_matched == n;
+}
+
 void testcase()
 {
   int n, c, f;
@@ -15,68 +131,62 @@ void testcase()
   assert(c >= 1 && c <= 100);
   assert(f >= 0);
 
-  std::map<std::string, int> ids_by_c;
-  std::vector<std::vector<int>> cs_by_student(n);
-  std::vector<std::vector<bool>> student_masks_by_c;
+  // every characteristic gets a dense id on first sight
+  std::unordered_map<std::string, int> ids_by_c;
+  ids_by_c.reserve(n * c);
+  std::vector<int> cs_by_student(n * c);
   for (int i = 0; i < n; i++)
   {
-    std::vector<int> &cs_this_student = cs_by_student.at(i);
     for (int j = 0; j < c; j++)
     {
       std::string c_name;
       std::cin >> c_name;
       assert(c_name.size() <= 20);
-      if (ids_by_c.count(c_name) == 0)
-      {
-        ids_by_c.insert(std::make_pair(c_name, ids_by_c.size()));
-        student_masks_by_c.emplace_back(std::vector<bool>(n, false));
-      }
-      int c_id = ids_by_c.at(c_name);
-
-      cs_this_student.push_back(c_id);
-      student_masks_by_c.at(c_id).at(i) = true;
+      cs_by_student.at(i * c + j) = ids_by_c.emplace(std::move(c_name), ids_by_c.size()).first->second;
     }
   }
 
-  Graph G(n);
+  // student i has characteristic k iff bit k % 64 of c_words[i * num_c_words + k / 64] is set
+  int num_c_words = (ids_by_c.size() + word_bits - 1) / word_bits;
+  std::vector<uint64_t> c_words(n * num_c_words, 0);
   for (int i = 0; i < n; i++)
   {
+    for (int j = 0; j < c; j++)
+    {
+      int c_id = cs_by_student.at(i * c + j);
+      c_words.at(i * num_c_words + c_id / word_bits) |= uint64_t(1) << (c_id % word_bits);
+    }
+  }
+
+  // buddies_by_student[i] lists the students j > i which share more than f characteristics with i
+  std::vector<std::vector<int>> buddies_by_student(n);
+  for_each_row_in_parallel(n, [&](int i) {
+    const uint64_t *words_i = c_words.data() + i * num_c_words;
     for (int j = i + 1; j < n; j++)
     {
-      int overlap_count_lower_bound = 0;
-      for (auto c_id : cs_by_student.at(i))
+      const uint64_t *words_j = c_words.data() + j * num_c_words;
+      int overlap_count = 0;
+      for (int k = 0; k < num_c_words; k++)
       {
-        if (student_masks_by_c.at(c_id).at(j))
-        {
-          overlap_count_lower_bound++;
-        }
-        if (overlap_count_lower_bound > f)
-        {
-          break;
-        }
+        overlap_count += __builtin_popcountll(words_i[k] & words_j[k]);
       }
-
-      if (overlap_count_lower_bound > f)
+      if (overlap_count > f)
       {
-        boost::add_edge(i, j, G);
+        buddies_by_student[i].push_back(j);
       }
     }
-  }
-
-  std::vector<Graph::vertex_descriptor> mate(n);
-  bool success = boost::checked_edmonds_maximum_cardinality_matching(G, &mate[0]);
-  assert(success);
+  });
 
-  bool all_matched = true;
-  for (auto its = boost::vertices(G); its.first != its.second; its.first++)
+  Graph G(n);
+  for (int i = 0; i < n; i++)
   {
-    if (mate[*its.first] == Graph::null_vertex())
+    for (int j : buddies_by_student.at(i))
     {
-      all_matched = false;
+      boost::add_edge(i, j, G);
     }
   }
 
-  std::cout << (all_matched ? "not optimal" : "optimal") << "\n";
+  std::cout << (has_perfect_matching(G) ? "not optimal" : "optimal") << "\n";
 }
 
 int main()
@@ -91,4 +201,4 @@ int main()
   }
 
   return 0;
-}
\ No newline at end of file
+}
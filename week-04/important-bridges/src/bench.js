@@ -0,0 +1,79 @@
+const child_process = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+const COMPILED_ALGORITHM_PATH = "../a"; // relative to this JS file
+
+function randomInt(min, max) {
+  return min + Math.floor(Math.random() * (max - min + 1));
+}
+
+// genPathInput returns a path through n nodes in random order, so all n - 1 edges are
+// bridges and the DFS goes n nodes deep
+function genPathInput(n) {
+  const order = Array.from({ length: n }, (_, i) => i);
+  for (let i = n - 1; i > 0; i--) {
+    const j = randomInt(0, i);
+    [order[i], order[j]] = [order[j], order[i]];
+  }
+  const edges = [];
+  for (let i = 0; i + 1 < n; i++) {
+    edges.push([order[i], order[i + 1]]);
+  }
+  return { n, edges, numBridges: n - 1 };
+}
+
+// genDenseWithTailInput returns a cycle through the first denseN nodes plus random
+// chords between them, which has no bridges, and a path of the remaining nodes hanging
+// off node 0, whose edges are all bridges
+function genDenseWithTailInput(n, m) {
+  const denseN = Math.floor(n / 2);
+  const edges = [];
+  for (let i = 0; i < denseN; i++) {
+    edges.push([i, (i + 1) % denseN]);
+  }
+  for (let i = denseN; i < n; i++) {
+    edges.push([i === denseN ? 0 : i - 1, i]);
+  }
+  const numBridges = n - denseN;
+  while (edges.length < m) {
+    const a = randomInt(0, denseN - 1), b = randomInt(0, denseN - 1);
+    if (a !== b) {
+      edges.push([a, b]);
+    }
+  }
+  return { n, edges, numBridges };
+}
+
+function inputToString(input) {
+  const lines = ["1", `${input.n} ${input.edges.length}`];
+  for (const [a, b] of input.edges) {
+    lines.push(`${a} ${b}`);
+  }
+  return lines.join("\n") + "\n";
+}
+
+function bench(name, input, runs) {
+  const inputPath = path.join(os.tmpdir(), `important-bridges-bench-${name}.txt`);
+  fs.writeFileSync(inputPath, inputToString(input));
+  const times = [];
+  for (let i = 0; i < runs; i++) {
+    const start = process.hrtime.bigint();
+    const output = child_process.execSync(
+      `${path.join(__dirname, COMPILED_ALGORITHM_PATH).replace(/ /g, "\\ ")} < ${inputPath}`,
+      { maxBuffer: 1 << 30 }
+    );
+    times.push(Number(process.hrtime.bigint() - start) / 1e6);
+    const numBridges = +output.toString().split("\n", 1)[0];
+    if (numBridges !== input.numBridges) {
+      throw new Error(`${name}: ${numBridges} bridges, expected ${input.numBridges}`);
+    }
+  }
+  times.sort((a, b) => a - b);
+  console.log(`${name}, n = ${input.n}, m = ${input.edges.length}: median ${times[Math.floor(runs / 2)].toFixed(1)} ms`);
+  fs.unlinkSync(inputPath);
+}
+
+bench("path", genPathInput(1000000), 3);
+bench("dense-with-tail", genDenseWithTailInput(200000, 1000000), 3);
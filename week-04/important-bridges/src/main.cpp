@@ -1,48 +1,382 @@
 #include <iostream>
 #include <cassert>
+#include <limits>
 #include <vector>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/iterator/function_output_iterator.hpp>
-#include <boost/graph/biconnected_components.hpp>
+#include <algorithm>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
+{
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
+
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
+
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
+
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
+
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
+  }
+
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
+  }
+
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
+{
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
+  {
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
+    {
+      write_char(*s++);
+    }
+  }
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
+// counting_sort_edges returns the indices of edges, stably sorted by key(edge index),
+// where every key is in [0, num_keys).
+template <typename Key>
+std::vector<int> counting_sort_edges(const std::vector<int> &edge_indices, int num_keys, Key key)
+{
+  std::vector<int> offsets(num_keys + 1, 0);
+  for (int i : edge_indices)
+  {
+    offsets.at(key(i) + 1)++;
+  }
+  for (int k = 0; k < num_keys; k++)
+  {
+    offsets.at(k + 1) += offsets.at(k);
+  }
+  std::vector<int> sorted(edge_indices.size());
+  for (int i : edge_indices)
+  {
+    sorted.at(offsets.at(key(i))++) = i;
+  }
+  return sorted;
+}
+
+// find_bridges marks every edge whose removal disconnects its endpoints. It runs
+// Tarjan's low-link DFS with an explicit stack, so the depth of the graph does not
+// matter. The graph is in compressed sparse row form: the edges at node a are
+// edge_ids[offsets[a]..offsets[a + 1]) and lead to the nodes in targets. The edge
+// used to enter a node is skipped by id rather than by endpoint, so parallel edges
+// are never bridges.
+std::vector<bool> find_bridges(const std::vector<int> &offsets, const std::vector<int> &targets, const std::vector<int> &edge_ids, int m)
+{
+  int n = offsets.size() - 1;
+  std::vector<bool> is_bridge(m, false);
+  std::vector<int> discovery_time(n, -1), low(n), parent_edge(n), next_slot(offsets.begin(), offsets.end() - 1), stack;
+  int time = 0;
+  for (int root = 0; root < n; root++)
+  {
+    if (discovery_time[root] != -1)
+    {
+      continue;
+    }
+    discovery_time[root] = low[root] = time++;
+    parent_edge[root] = -1;
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+      int a = stack.back();
+      if (next_slot[a] < offsets[a + 1])
+      {
+        int j = next_slot[a]++;
+        int b = targets[j], edge = edge_ids[j];
+        if (edge == parent_edge[a])
+        {
+          continue;
+        }
+        if (discovery_time[b] == -1)
+        {
+          discovery_time[b] = low[b] = time++;
+          parent_edge[b] = edge;
+          stack.push_back(b);
+        }
+        else
+        {
+          low[a] = std::min(low[a], discovery_time[b]);
+        }
+        continue;
+      }
+
+      stack.pop_back();
+      if (parent_edge[a] != -1)
+      {
+        int parent = stack.back();
+        low[parent] = std::min(low[parent], low[a]);
+        if (low[a] > discovery_time[parent])
+        {
+          is_bridge[parent_edge[a]] = true;
+        }
+      }
+    }
+  }
+  return is_bridge;
+}
 
 void testcase()
 {
-  int n, m;
-  std::cin >> n >> m;
-  assert(n >= 0 && n <= 30000 && m >= 0 && m <= 30000);
+  int n = input.read_int(), m = input.read_int();
+  assert(n >= 0 && n <= 1e6 && m >= 0 && m <= 1e6);
 
-  Graph G(n + m);
-  std::vector<std::pair<int, int>> edges;
+  std::vector<int> starts(m), ends(m), offsets(n + 1, 0);
   for (int i = 0; i < m; i++)
   {
-    int start, end;
-    std::cin >> start >> end;
+    int start = input.read_int(), end = input.read_int();
     if (start > end)
     {
       std::swap(start, end);
     }
     assert(start >= 0 && start < n && end >= 0 && end < n && start < end);
-    edges.push_back(std::make_pair(start, end));
-    boost::add_edge(start, n + i, G);
-    boost::add_edge(n + i, end, G);
+    starts.at(i) = start;
+    ends.at(i) = end;
+    offsets.at(start + 1)++;
+    offsets.at(end + 1)++;
   }
 
-  std::vector<std::pair<int, int>> critical_bridges;
-  auto on_articulation = [n, &critical_bridges, &edges](int vertex) {
-    if (vertex >= n)
-    {
-      critical_bridges.push_back(edges.at(vertex - n));
-    }
-  };
-  boost::articulation_points(G, boost::make_function_output_iterator(on_articulation));
+  // edges sorted by (start, end) in linear time, which is the order bridges are printed in
+  std::vector<int> edge_order(m);
+  for (int i = 0; i < m; i++)
+  {
+    edge_order.at(i) = i;
+  }
+  edge_order = counting_sort_edges(edge_order, n, [&](int i) { return ends[i]; });
+  edge_order = counting_sort_edges(edge_order, n, [&](int i) { return starts[i]; });
 
-  std::cout << critical_bridges.size() << "\n";
-  std::sort(critical_bridges.begin(), critical_bridges.end());
-  for (auto bridge : critical_bridges)
+  for (int a = 0; a < n; a++)
   {
-    std::cout << bridge.first << " " << bridge.second << "\n";
+    offsets.at(a + 1) += offsets.at(a);
+  }
+  std::vector<int> targets(2 * m), edge_ids(2 * m), next_slot(offsets.begin(), offsets.end() - 1);
+  for (int i : edge_order)
+  {
+    targets.at(next_slot.at(starts[i])) = ends[i];
+    edge_ids.at(next_slot.at(starts[i])++) = i;
+    targets.at(next_slot.at(ends[i])) = starts[i];
+    edge_ids.at(next_slot.at(ends[i])++) = i;
+  }
+
+  std::vector<bool> is_bridge = find_bridges(offsets, targets, edge_ids, m);
+  output.write_int(std::count(is_bridge.begin(), is_bridge.end(), true));
+  output.write_char('\n');
+  for (int i : edge_order)
+  {
+    if (is_bridge[i])
+    {
+      output.write_int(starts[i]);
+      output.write_char(' ');
+      output.write_int(ends[i]);
+      output.write_char('\n');
+    }
   }
 }
 
@@ -50,8 +384,7 @@ int main()
 {
   std::ios_base::sync_with_stdio(false);
 
-  int t;
-  std::cin >> t;
+  int t = input.read_int();
   for (int i = 0; i < t; i++)
   {
     testcase();
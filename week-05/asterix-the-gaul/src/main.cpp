@@ -29,9 +29,9 @@ public:
     this->t = _t;
   }
 
-  friend inline bool operator<(const Movement &a, const Movement &b)
+  friend inline Movement operator+(const Movement &a, const Movement &b)
   {
-    return a.t < b.t || (a.t == b.t && a.d < b.d);
+    return Movement(a.d + b.d, a.t + b.t);
   }
 };
 
@@ -49,107 +49,100 @@ void print_vec(std::vector<T> &vec, std::ostream &stream)
   stream << "\n";
 }
 
-std::vector<std::vector<Movement>> list_best_combined_movements(const std::vector<Movement> &movements, long T)
+// merge_frontiers merges the frontier a with the frontier b shifted by offset. A
+// frontier is sorted by strictly increasing t and strictly increasing d, so no entry
+// is dominated by another (at most the time and at least the distance). Entries which
+// take T or more time are dropped.
+std::vector<Movement> merge_frontiers(const std::vector<Movement> &a, const std::vector<Movement> &b, const Movement &offset, long T)
 {
-  int n = int(movements.size());
-  int num_combos = 1 << n;
-  std::vector<std::vector<Movement>> combined_movements(n + 1);
-  for (int mask = 0; mask < num_combos; mask++)
+  std::vector<Movement> merged;
+  merged.reserve(a.size() + b.size());
+  long best_d = -1;
+  auto it_a = a.begin(), it_b = b.begin();
+  while (true)
   {
-    Movement combined(0, 0);
-    for (int i = 0; i < n; i++)
+    bool has_a = it_a != a.end() && it_a->t < T;
+    bool has_b = it_b != b.end() && it_b->t + offset.t < T;
+    Movement next;
+    if (has_a && (!has_b || it_a->t < it_b->t + offset.t || (it_a->t == it_b->t + offset.t && it_a->d >= it_b->d + offset.d)))
     {
-      if (mask & (1 << i))
-      {
-        const Movement &movement = movements.at(i);
-        combined.d += movement.d;
-        combined.t += movement.t;
-      }
+      next = *it_a++;
+    }
+    else if (has_b)
+    {
+      next = *it_b++ + offset;
+    }
+    else
+    {
+      break;
     }
-    if (combined.t < T)
+    if (next.d > best_d)
     {
-      combined_movements.at(__builtin_popcount(mask)).push_back(combined);
+      merged.push_back(next);
+      best_d = next.d;
     }
   }
+  return merged;
+}
 
-  std::vector<std::vector<Movement>> best_combined_movements;
-  for (auto &group : combined_movements)
+// pareto_frontiers_by_count returns, for every number of movements k, the frontier of
+// all combinations of exactly k movements that take less than T time. The frontiers are
+// built by adding one movement at a time and merging the frontier of k movements with
+// the shifted frontier of k - 1 movements, so they come out sorted without a comparison
+// sort and dominated combinations are dropped as early as possible.
+std::vector<std::vector<Movement>> pareto_frontiers_by_count(const std::vector<Movement> &movements, long T)
+{
+  std::vector<std::vector<Movement>> frontiers{{Movement(0, 0)}};
+  for (const Movement &movement : movements)
   {
-    std::vector<Movement> modified_group;
-
-    if (!group.empty())
+    frontiers.emplace_back();
+    for (int k = int(frontiers.size()) - 1; k >= 1; k--)
     {
-      long best_d = 0, last_t = -1;
-      std::sort(group.begin(), group.end());
-      for (Movement &movement : group)
-      {
-        if (movement.t != last_t)
-        {
-          if (last_t >= 0)
-          {
-            modified_group.push_back(Movement(best_d, last_t));
-          }
-          last_t = movement.t;
-        }
-        best_d = std::max(best_d, movement.d);
-      }
-      assert(last_t >= 0);
-      modified_group.push_back(Movement(best_d, last_t));
+      frontiers.at(k) = merge_frontiers(frontiers.at(k), frontiers.at(k - 1), movement, T);
     }
-
-    best_combined_movements.push_back(modified_group);
   }
 
-  return best_combined_movements;
+  return frontiers;
 }
 
 std::vector<long> get_furtherest_by_num_movements(const std::vector<Movement> &movements, long D, long T)
 {
   int n = int(movements.size());
-  auto combined_movements_a = list_best_combined_movements(std::vector<Movement>(movements.begin(), movements.begin() + n / 2), T);
-  auto combined_movements_b = list_best_combined_movements(std::vector<Movement>(movements.begin() + n / 2, movements.end()), T);
+  auto frontiers_a = pareto_frontiers_by_count(std::vector<Movement>(movements.begin(), movements.begin() + n / 2), T);
+  auto frontiers_b = pareto_frontiers_by_count(std::vector<Movement>(movements.begin() + n / 2, movements.end()), T);
 
-  for (auto &group_b : combined_movements_b)
+  for (auto &frontier_b : frontiers_b)
   {
-    DEBUG(3, "group");
-    for (auto &b : group_b)
+    DEBUG(3, "frontier");
+    for (auto &b : frontier_b)
     {
       DEBUG(3, "b.d " << b.d << " b.t " << b.t);
     }
   }
 
   std::vector<long> furtherest_by_num_movements(n + 1, too_many_movements);
-  for (int num_a = 0; num_a < int(combined_movements_a.size()); num_a++)
+  for (int num_a = 0; num_a < int(frontiers_a.size()); num_a++)
   {
-    std::vector<Movement> &group_a = combined_movements_a.at(num_a);
-    for (int num_b = 0; num_b < int(combined_movements_b.size()); num_b++)
+    const std::vector<Movement> &frontier_a = frontiers_a.at(num_a);
+    for (int num_b = 0; num_b < int(frontiers_b.size()); num_b++)
     {
-      std::vector<Movement> &group_b = combined_movements_b.at(num_b);
-      if (group_b.empty())
-      {
-        continue;
-      }
+      const std::vector<Movement> &frontier_b = frontiers_b.at(num_b);
       long &best = furtherest_by_num_movements.at(num_a + num_b);
       DEBUG(3, "num_a " << num_a << " num_b " << num_b);
 
-      for (Movement &a : group_a)
+      // as a gets slower, the fastest fitting b can only get faster
+      auto b = frontier_b.rbegin();
+      for (const Movement &a : frontier_a)
       {
-        DEBUG(3, "a.d " << a.d << " a.t " << a.t);
-        auto b = std::upper_bound(group_b.begin(), group_b.end(), Movement(0, T - a.t));
-        DEBUG(3, "index of b " << b - group_b.begin());
-        if (b != group_b.end())
-        {
-          DEBUG(3, "b->d " << b->d << " b->t " << b->t);
-        }
-        if (b != group_b.begin())
+        while (b != frontier_b.rend() && a.t + b->t >= T)
         {
-          b--;
+          b++;
         }
-        DEBUG(3, "b->d " << b->d << " b->t " << b->t);
-        if (a.t + b->t >= T)
+        if (b == frontier_b.rend())
         {
-          continue;
+          break;
         }
+        DEBUG(3, "a.d " << a.d << " a.t " << a.t << " b->d " << b->d << " b->t " << b->t);
         best = std::max(best, a.d + b->d);
       }
     }
@@ -202,12 +195,8 @@ void testcase()
       {
         continue;
       }
-      // HACK add in steps to avoid overflow
-      for (int j = 0; j < num_movements && d < D; j++)
-      {
-        d += extra_per_step;
-      }
-      if (d >= D)
+      // d + num_movements * extra_per_step >= D, without overflowing
+      if (d >= D || extra_per_step >= (D - d + num_movements - 1) / num_movements)
       {
         return true;
       }
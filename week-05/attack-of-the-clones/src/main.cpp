@@ -5,6 +5,12 @@
 #include <map>
 #include <set>
 #include <limits>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 const int debug_level = 0;
 #define DEBUG(min_level, x)      \
@@ -18,6 +24,237 @@ const int max_jedi_in_some_segment = 10;
 typedef std::pair<int, int> Segment;
 typedef std::pair<std::vector<Segment>, std::vector<Segment>> FlatProblem;
 
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
+{
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
+
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
+
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
+
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
+
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
+  }
+
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
+  }
+
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
+{
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
+  {
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
+    {
+      write_char(*s++);
+    }
+  }
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
 int find_min_location(int n, int m, const std::vector<Segment> &circular_jedi_segments)
 {
   assert(int(circular_jedi_segments.size()) == n);
@@ -140,31 +377,110 @@ FlatProblem flatten_jedi_problem(int n, int m, const std::vector<Segment> &circu
   return return_value;
 }
 
-int solve_flat_jedi_problem(int n, int m, FlatProblem &flat_problem)
+// IntervalScheduler answers how many pairwise disjoint closed intervals fit into a
+// range [next_free, first_blocked) of a line, which is what the greedy "take the
+// interval that ends first" scheduler computes. After sorting the intervals by end
+// once, it stores for every interval the interval the greedy would take right after
+// it, and jump pointers to the 2^k-th such interval (binary lifting). A query then
+// follows at most log n pointers instead of scanning every interval.
+class IntervalScheduler
 {
-  std::vector<Segment> &flat_jedi_segments = flat_problem.first;
-  std::vector<Segment> &unflattenable_jedi_segments = flat_problem.second;
-  assert(int(flat_jedi_segments.size() + unflattenable_jedi_segments.size()) == n);
+public:
+  IntervalScheduler(const std::vector<Segment> &intervals)
+  {
+    int n = intervals.size();
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++)
+    {
+      order.at(i) = i;
+    }
+    std::sort(order.begin(), order.end(), [&intervals](int a, int b) { return intervals.at(a).second < intervals.at(b).second; });
+    for (int i : order)
+    {
+      starts.push_back(intervals.at(i).first);
+      ends.push_back(intervals.at(i).second);
+    }
 
-  std::sort(flat_jedi_segments.begin(), flat_jedi_segments.end(), [](Segment a, Segment b) { return a.second < b.second; });
+    // first_by_start[i] is the earliest ending interval among those with the i
+    // smallest starts removed, in the order of sorted_starts
+    std::vector<int> by_start(n);
+    for (int i = 0; i < n; i++)
+    {
+      by_start.at(i) = i;
+    }
+    std::sort(by_start.begin(), by_start.end(), [this](int a, int b) { return starts.at(a) < starts.at(b); });
+    sorted_starts.resize(n);
+    first_by_start.assign(n + 1, n);
+    for (int i = n - 1; i >= 0; i--)
+    {
+      sorted_starts.at(i) = starts.at(by_start.at(i));
+      first_by_start.at(i) = std::min(first_by_start.at(i + 1), by_start.at(i));
+    }
 
-  auto solve = [&flat_jedi_segments](int next_free, int first_blocked, int used_jedi) {
-    for (auto &segment : flat_jedi_segments)
+    // interval n is a sentinel which jumps to itself
+    jumps.emplace_back(n + 1, n);
+    for (int i = 0; i < n; i++)
+    {
+      jumps.at(0).at(i) = first_starting_from(ends.at(i) + 1);
+    }
+    for (int k = 1; (1 << k) <= n; k++)
     {
-      if (segment.first < next_free || segment.second >= first_blocked)
+      const std::vector<int> &half_jumps = jumps.at(k - 1);
+      std::vector<int> full_jumps(n + 1);
+      for (int i = 0; i <= n; i++)
       {
-        continue;
+        full_jumps.at(i) = half_jumps.at(half_jumps.at(i));
       }
-      used_jedi++;
-      next_free = segment.second + 1;
+      jumps.push_back(std::move(full_jumps));
     }
-    return used_jedi;
-  };
+  }
+
+  // max_disjoint returns the maximum number of pairwise disjoint intervals which start
+  // at or after next_free and end before first_blocked.
+  int max_disjoint(int next_free, int first_blocked) const
+  {
+    int n = ends.size();
+    int i = first_starting_from(next_free);
+    if (i == n || ends.at(i) >= first_blocked)
+    {
+      return 0;
+    }
+    int count = 1;
+    for (int k = int(jumps.size()) - 1; k >= 0; k--)
+    {
+      int j = jumps.at(k).at(i);
+      if (j != n && ends.at(j) < first_blocked)
+      {
+        count += 1 << k;
+        i = j;
+      }
+    }
+    return count;
+  }
+
+private:
+  // first_starting_from returns the earliest ending interval which starts at or after
+  // position, or n if there is none
+  int first_starting_from(int position) const
+  {
+    return first_by_start.at(std::lower_bound(sorted_starts.begin(), sorted_starts.end(), position) - sorted_starts.begin());
+  }
+
+  std::vector<int> starts, ends, sorted_starts, first_by_start;
+  std::vector<std::vector<int>> jumps;
+};
+
+int solve_flat_jedi_problem(int n, int m, FlatProblem &flat_problem)
+{
+  std::vector<Segment> &flat_jedi_segments = flat_problem.first;
+  std::vector<Segment> &unflattenable_jedi_segments = flat_problem.second;
+  assert(int(flat_jedi_segments.size() + unflattenable_jedi_segments.size()) == n);
 
-  int max_used_jedi = solve(0, m, 0);
+  IntervalScheduler scheduler(flat_jedi_segments);
+  int max_used_jedi = scheduler.max_disjoint(0, m);
   for (Segment &blocked_segment : unflattenable_jedi_segments)
   {
-    int used_jedi = solve(blocked_segment.second + 1, blocked_segment.first, 1);
+    int used_jedi = 1 + scheduler.max_disjoint(blocked_segment.second + 1, blocked_segment.first);
     max_used_jedi = std::max(max_used_jedi, used_jedi);
   }
   return max_used_jedi;
@@ -172,30 +488,28 @@ int solve_flat_jedi_problem(int n, int m, FlatProblem &flat_problem)
 
 void testcase()
 {
-  int n, m;
-  std::cin >> n >> m;
+  int n = input.read_int(), m = input.read_int();
   DEBUG(1, "n " << n << " m " << m);
   assert(n >= 1 && n <= 5e4 && m >= 1 && m <= 1e9);
 
   std::vector<Segment> circular_jedi_segments(n);
   for (int i = 0; i < n; i++)
   {
-    int a, b;
-    std::cin >> a >> b;
+    int a = input.read_int(), b = input.read_int();
     assert(a >= 1 && a <= m && b >= 1 && b <= m);
     circular_jedi_segments.at(i) = std::make_pair(a, b);
   }
 
   FlatProblem flat_problem = flatten_jedi_problem(n, m, circular_jedi_segments);
-  std::cout << solve_flat_jedi_problem(n, m, flat_problem) << "\n";
+  output.write_int(solve_flat_jedi_problem(n, m, flat_problem));
+  output.write_char('\n');
 }
 
 int main()
 {
   std::ios_base::sync_with_stdio(false);
 
-  int t;
-  std::cin >> t;
+  int t = input.read_int();
   for (int i = 0; i < t; i++)
   {
     testcase();
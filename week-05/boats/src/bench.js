@@ -0,0 +1,61 @@
+const child_process = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+// relative to this JS file
+// "../a-vector" is the same solution built from a revision that still scans a vector of boats
+const COMPILED_ALGORITHM_PATHS = ["../a-vector", "../a"];
+
+// genWorstCaseInput returns a test case where half of the boats are so long that they
+// can start anywhere, but have their rings at the very end. They are candidates for
+// the whole run while the short boats get tied one by one.
+function genWorstCaseInput(n) {
+  const lines = ["1", `${n}`];
+  const numShort = Math.floor(n / 2);
+  for (let i = 0; i < numShort; i++) {
+    lines.push(`${Math.floor(Math.random() * 3) + 1} ${3 * (i + 1)}`);
+  }
+  for (let i = numShort; i < n; i++) {
+    lines.push(`${1000000 - Math.floor(Math.random() * 1000)} ${1000000 - (n - i)}`);
+  }
+  return lines.join("\n") + "\n";
+}
+
+function genRandomInput(n) {
+  const lines = ["1", `${n}`];
+  for (let i = 0; i < n; i++) {
+    lines.push(
+      `${Math.floor(Math.random() * 1000) + 1} ${Math.floor(Math.random() * 1000000) + 1}`
+    );
+  }
+  return lines.join("\n") + "\n";
+}
+
+function timeAlgorithm(algorithmPath, inputPath) {
+  const start = process.hrtime.bigint();
+  child_process.execSync(
+    `${path.join(__dirname, algorithmPath).replace(/ /g, "\\ ")} < ${inputPath}`,
+    { stdio: ["ignore", "ignore", "inherit"] }
+  );
+  return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+function bench(name, genInput, n) {
+  const inputPath = path.join(os.tmpdir(), `boats-bench-${name}-${n}.txt`);
+  fs.writeFileSync(inputPath, genInput(n));
+  for (const algorithmPath of COMPILED_ALGORITHM_PATHS) {
+    console.log(
+      `${name}, n = ${n}, ${algorithmPath}: ${timeAlgorithm(
+        algorithmPath,
+        inputPath
+      ).toFixed(1)} ms`
+    );
+  }
+  fs.unlinkSync(inputPath);
+}
+
+for (const n of [1000, 10000, 100000]) {
+  bench("random", genRandomInput, n);
+  bench("worst-case", genWorstCaseInput, n);
+}
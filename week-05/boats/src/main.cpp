@@ -4,22 +4,260 @@
 #include <limits>
 #include <algorithm>
 #include <queue>
+#include <tuple>
+#include <utility>
+#include <functional>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 const int debug_level = 0;
 
 const int dp_undefined = -1;
 
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
+{
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
+
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
+
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
+
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
+
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
+  }
+
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
+  }
+
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
+{
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
+  {
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
+    {
+      write_char(*s++);
+    }
+  }
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
 void testcase()
 {
-  int n;
-  std::cin >> n;
+  int n = input.read_int();
   assert(n >= 1 && n <= 1e5);
 
   std::vector<int> boat_lengths(n), ring_positions(n);
   for (int i = 0; i < n; i++)
   {
-    int l, p;
-    std::cin >> l >> p;
+    int l = input.read_int(), p = input.read_int();
     assert(l >= 1 && l <= 1e6 && p >= 1 && p <= 1e6);
     boat_lengths.at(i) = l;
     ring_positions.at(i) = p;
@@ -44,13 +282,24 @@ void testcase()
     return ring_positions.at(a) < ring_positions.at(b);
   });
 
-  std::vector<int> cur_length_limited_indices;
-  int next_ring_limited = 0, next_length_limited = 0, cur_pos = std::numeric_limits<int>::min(), tied_boats = 0, last_chosen_i = -1;
+  // Boats which have been reached by next_length_limited are kept in two heaps with
+  // lazy deletion. Their next position max(cur_pos + length, ring position) is
+  // cur_pos + length if their earliest start is at most cur_pos (length_limited_heap,
+  // ordered by length), otherwise their ring position (ring_limited_heap, ordered by
+  // ring position). Entries are (key, rank) pairs, where rank is the boat's index in
+  // indices_sorted_by_earliest_start, so ties are broken in the order the boats were
+  // reached. For equal lengths that is also the order of ring positions. Since cur_pos only
+  // grows, boats move from the second heap to the first in that same order, and boats
+  // which are tied or whose ring position is behind cur_pos never come back.
+  typedef std::pair<int, int> HeapEntry;
+  std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> length_limited_heap, ring_limited_heap;
+  std::vector<bool> is_tied(n, false);
+  int next_ring_limited = 0, next_length_limited = 0, next_moved_to_length_limited = 0, cur_pos = std::numeric_limits<int>::min(), tied_boats = 0;
   while (true)
   {
     if (debug_level >= 2)
     {
-      std::cout << "next_length_limited " << next_length_limited << " cur_pos " << cur_pos << " tied_boats " << tied_boats << std::endl;
+      std::cerr << "next_length_limited " << next_length_limited << " cur_pos " << cur_pos << " tied_boats " << tied_boats << std::endl;
     }
 
     int chosen_i = -1;
@@ -59,7 +308,7 @@ void testcase()
     {
       int i = indices_sorted_by_ring_position.at(next_ring_limited);
       next_ring_limited++;
-      if (ring_positions.at(i) >= cur_pos && i != last_chosen_i)
+      if (ring_positions.at(i) >= cur_pos && !is_tied.at(i))
       {
         chosen_i = i;
         chosen_next_pos = std::max(cur_pos + boat_lengths.at(i), ring_positions.at(i));
@@ -73,64 +322,96 @@ void testcase()
     assert(chosen_i >= 0 && chosen_i < n && chosen_next_pos >= 1);
     if (debug_level >= 3)
     {
-      std::cout << "chosen_i " << chosen_i << " chosen_next_pos " << chosen_next_pos << std::endl;
-    }
-
-    if (debug_level >= 2)
-    {
-      std::cout << "cur_length_limited_indices.size() before add " << cur_length_limited_indices.size() << std::endl;
+      std::cerr << "chosen_i " << chosen_i << " chosen_next_pos " << chosen_next_pos << std::endl;
     }
 
+    // boats with a later earliest start end after chosen_next_pos, so they can wait
     while (next_length_limited < n && boat_earliest_starts.at(indices_sorted_by_earliest_start.at(next_length_limited)) <= (tied_boats > 0 ? chosen_next_pos : cur_pos))
     {
-      cur_length_limited_indices.push_back(indices_sorted_by_earliest_start.at(next_length_limited));
+      int i = indices_sorted_by_earliest_start.at(next_length_limited);
+      if (next_moved_to_length_limited == next_length_limited && boat_earliest_starts.at(i) <= cur_pos)
+      {
+        length_limited_heap.emplace(boat_lengths.at(i), next_length_limited);
+        next_moved_to_length_limited++;
+      }
+      else
+      {
+        ring_limited_heap.emplace(ring_positions.at(i), next_length_limited);
+      }
       next_length_limited++;
     }
-
-    if (debug_level >= 2)
+    while (next_moved_to_length_limited < next_length_limited && boat_earliest_starts.at(indices_sorted_by_earliest_start.at(next_moved_to_length_limited)) <= cur_pos)
     {
-      std::cout << "cur_length_limited_indices.size() before erase " << cur_length_limited_indices.size() << std::endl;
+      int i = indices_sorted_by_earliest_start.at(next_moved_to_length_limited);
+      length_limited_heap.emplace(boat_lengths.at(i), next_moved_to_length_limited);
+      next_moved_to_length_limited++;
     }
 
-    cur_length_limited_indices.erase(std::remove_if(cur_length_limited_indices.begin(), cur_length_limited_indices.end(), [&ring_positions, cur_pos, last_chosen_i](int i) { return i == last_chosen_i || ring_positions.at(i) < cur_pos; }), cur_length_limited_indices.end());
-
+    while (!length_limited_heap.empty())
+    {
+      int i = indices_sorted_by_earliest_start.at(length_limited_heap.top().second);
+      if (!is_tied.at(i) && ring_positions.at(i) >= cur_pos)
+      {
+        break;
+      }
+      length_limited_heap.pop();
+    }
+    while (!ring_limited_heap.empty())
+    {
+      int i = indices_sorted_by_earliest_start.at(ring_limited_heap.top().second);
+      if (!is_tied.at(i) && boat_earliest_starts.at(i) > cur_pos)
+      {
+        break;
+      }
+      ring_limited_heap.pop();
+    }
     if (debug_level >= 2)
     {
-      std::cout << "cur_length_limited_indices.size() before minimum " << cur_length_limited_indices.size() << std::endl;
+      std::cerr << "heap sizes " << length_limited_heap.size() << " " << ring_limited_heap.size() << std::endl;
     }
 
-    for (auto i : cur_length_limited_indices)
+    // best_rank is the rank of the best boat from the heaps, which has to beat chosen_i
+    int best_rank = -1, best_next_pos, best_ring_position;
+    if (!length_limited_heap.empty())
+    {
+      best_rank = length_limited_heap.top().second;
+      best_next_pos = cur_pos + length_limited_heap.top().first;
+      best_ring_position = ring_positions.at(indices_sorted_by_earliest_start.at(best_rank));
+    }
+    if (!ring_limited_heap.empty())
     {
-      int next_pos = std::max(cur_pos + boat_lengths.at(i), ring_positions.at(i));
-      if (debug_level >= 3)
+      int rank = ring_limited_heap.top().second, ring_position = ring_limited_heap.top().first;
+      if (best_rank == -1 || std::make_tuple(ring_position, ring_position, rank) < std::make_tuple(best_next_pos, best_ring_position, best_rank))
       {
-        std::cout << "i " << i << " next_pos " << next_pos << std::endl;
+        best_rank = rank;
+        best_next_pos = ring_position;
+        best_ring_position = ring_position;
       }
-      if (next_pos < chosen_next_pos || (next_pos == chosen_next_pos && ring_positions.at(i) < ring_positions.at(chosen_i)))
+    }
+    if (best_rank != -1 && (best_next_pos < chosen_next_pos || (best_next_pos == chosen_next_pos && best_ring_position < ring_positions.at(chosen_i))))
+    {
+      chosen_i = indices_sorted_by_earliest_start.at(best_rank);
+      chosen_next_pos = best_next_pos;
+      if (debug_level >= 2)
       {
-        chosen_i = i;
-        chosen_next_pos = next_pos;
-        if (debug_level >= 2)
-        {
-          std::cout << "chosen_i " << chosen_i << std::endl;
-        }
+        std::cerr << "chosen_i " << chosen_i << std::endl;
       }
     }
     cur_pos = chosen_next_pos;
-    last_chosen_i = chosen_i;
+    is_tied.at(chosen_i) = true;
     tied_boats++;
   }
 
   assert(tied_boats >= 1 && tied_boats <= n);
-  std::cout << tied_boats << "\n";
+  output.write_int(tied_boats);
+  output.write_char('\n');
 }
 
 int main()
 {
   std::ios_base::sync_with_stdio(false);
 
-  int t;
-  std::cin >> t;
+  int t = input.read_int();
   for (int i = 0; i < t; i++)
   {
     testcase();
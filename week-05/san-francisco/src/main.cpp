@@ -1,6 +1,7 @@
 #include <iostream>
 #include <cassert>
 #include <vector>
+#include <algorithm>
 
 const int debug_level = 0;
 
@@ -12,69 +13,126 @@ const int debug_level = 0;
 
 const long unreachable_points = -1;
 
-void testcase()
+// RoundEngine computes the best score reachable after every move of the game. The
+// canals are stored in compressed sparse row form, with canals into holes without
+// outgoing canals already redirected to hole 0 (Weayaya). All buffers are members, so
+// one engine can be reused across test cases without allocating again once its
+// capacity is large enough.
+class RoundEngine
 {
-  int n, m, k;
-  long x;
-  std::cin >> n >> m >> x >> k;
-  assert(n >= 2 && n <= 1e3 && m >= 1 && m <= 4e3);
-  assert(x >= 1 && x <= 1e14 && k >= 1 && k <= 4e3);
-
-  std::vector<std::vector<std::pair<int, long>>> edges(m, std::vector<std::pair<int, long>>());
-  for (int i = 0; i < m; i++)
+public:
+  // load replaces the canal system. Canal i goes from us[i] to vs[i] and gives ps[i] points.
+  void load(int n, const std::vector<int> &us, const std::vector<int> &vs, const std::vector<long> &ps)
   {
-    int u, v;
-    long p;
-    std::cin >> u >> v >> p;
-    assert(u >= 0 && u < n && v >= 0 && v < n);
-    assert(p >= 0 && p < (long(1) << 31));
-    edges.at(u).push_back(std::make_pair(v, p));
+    int m = us.size();
+    offsets.assign(n + 1, 0);
+    for (int i = 0; i < m; i++)
+    {
+      offsets.at(us.at(i) + 1)++;
+    }
+    for (int j = 0; j < n; j++)
+    {
+      offsets.at(j + 1) += offsets.at(j);
+    }
+    targets.resize(m);
+    points.resize(m);
+    next_slot.assign(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < m; i++)
+    {
+      int v = vs.at(i);
+      int slot = next_slot.at(us.at(i))++;
+      targets.at(slot) = offsets.at(v) == offsets.at(v + 1) ? 0 : v;
+      points.at(slot) = ps.at(i);
+    }
   }
 
-  std::vector<long> last_row(n, unreachable_points);
-  last_row.at(0) = 0;
-  for (int i = 0; i < k; i++)
+  // min_moves_for_scores returns, for every score in sorted_scores (ascending), the
+  // smallest number of moves (at most k) after which some path has at least that
+  // score, or -1 if none exists. It stops as soon as the largest score is reached.
+  std::vector<int> min_moves_for_scores(int k, const std::vector<long> &sorted_scores)
   {
-    DEBUG(2, "i " << i);
-    std::vector<long> next_row(n, unreachable_points);
-    for (int j = 0; j < n; j++)
+    assert(std::is_sorted(sorted_scores.begin(), sorted_scores.end()));
+    int n = offsets.size() - 1;
+    std::vector<int> min_moves(sorted_scores.size(), -1);
+    size_t next_score = 0;
+
+    last_row.assign(n, unreachable_points);
+    next_row.resize(n);
+    last_row.at(0) = 0;
+    for (int i = 0; i < k && next_score < sorted_scores.size(); i++)
     {
-      DEBUG(2, "j " << j);
-      long last_points = last_row.at(j);
-      if (last_points == unreachable_points)
-      {
-        DEBUG(2, "unreachable");
-        continue;
-      }
-      for (auto &edge : edges.at(j))
+      DEBUG(2, "i " << i);
+      std::fill(next_row.begin(), next_row.end(), unreachable_points);
+      long best_points = unreachable_points;
+      for (int j = 0; j < n; j++)
       {
-        DEBUG(2, "edge to " << edge.first << " value " << edge.second);
-        int effective_target = edges.at(edge.first).empty() ? 0 : edge.first;
-        long &next_points = next_row.at(effective_target);
-        next_points = std::max(next_points, last_points + edge.second);
-        DEBUG(2, "next_points " << next_points);
-        if (next_points >= x)
+        long last_points = last_row[j];
+        if (last_points == unreachable_points)
+        {
+          continue;
+        }
+        for (int slot = offsets[j]; slot < offsets[j + 1]; slot++)
         {
-          std::cout << i + 1 << "\n";
-          return;
+          long &next_points = next_row[targets[slot]];
+          next_points = std::max(next_points, last_points + points[slot]);
+          best_points = std::max(best_points, next_points);
         }
       }
+      DEBUG(2, "best_points " << best_points);
+
+      while (next_score < sorted_scores.size() && best_points >= sorted_scores.at(next_score))
+      {
+        min_moves.at(next_score++) = i + 1;
+      }
+      std::swap(last_row, next_row);
     }
-    last_row = next_row;
+    return min_moves;
   }
 
-  std::cout << "Impossible\n";
+private:
+  std::vector<int> offsets, targets, next_slot;
+  std::vector<long> points, last_row, next_row;
+};
+
+void testcase(RoundEngine &engine)
+{
+  int n, m, k;
+  long x;
+  std::cin >> n >> m >> x >> k;
+  assert(n >= 2 && n <= 1e3 && m >= 1 && m <= 4e3);
+  assert(x >= 1 && x <= 1e14 && k >= 1 && k <= 4e3);
+
+  std::vector<int> us(m), vs(m);
+  std::vector<long> ps(m);
+  for (int i = 0; i < m; i++)
+  {
+    std::cin >> us.at(i) >> vs.at(i) >> ps.at(i);
+    assert(us.at(i) >= 0 && us.at(i) < n && vs.at(i) >= 0 && vs.at(i) < n);
+    assert(ps.at(i) >= 0 && ps.at(i) < (long(1) << 31));
+  }
+
+  engine.load(n, us, vs, ps);
+  int min_moves = engine.min_moves_for_scores(k, {x}).at(0);
+  if (min_moves == -1)
+  {
+    std::cout << "Impossible\n";
+  }
+  else
+  {
+    std::cout << min_moves << "\n";
+  }
 }
 
 int main()
 {
   std::ios_base::sync_with_stdio(false);
 
+  RoundEngine engine;
   int t;
   std::cin >> t;
   for (int i = 0; i < t; i++)
   {
-    testcase();
+    testcase(engine);
   }
 
   return 0;
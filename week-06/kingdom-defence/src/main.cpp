@@ -1,7 +1,8 @@
 #include <iostream>
 #include <cassert>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/push_relabel_max_flow.hpp>
+#include <vector>
+#include <limits>
+#include <algorithm>
 
 const int debug_level = 0;
 
@@ -11,13 +12,194 @@ const int debug_level = 0;
     std::cerr << x << std::endl; \
   }
 
-typedef boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS> GraphTraits;
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::no_property,
-                              boost::property<boost::edge_capacity_t, long,
-                                              boost::property<boost::edge_residual_capacity_t, long,
-                                                              boost::property<boost::edge_reverse_t, GraphTraits::edge_descriptor>>>>
-    Graph;
-typedef Graph::vertex_descriptor Vertex;
+// FlowNetwork is a directed flow network with a built-in max flow solver (Dinic's
+// algorithm). Edges are collected with add_edge into arrays reserved up front, and laid
+// out once in compressed sparse row form when the first flow is computed: the arcs
+// leaving node a are [arc_offsets[a], arc_offsets[a + 1]), and every arc stores the
+// index of its paired reverse arc. This avoids the allocation per arc and reverse arc
+// of a boost::adjacency_list.
+class FlowNetwork
+{
+public:
+  explicit FlowNetwork(int num_nodes, int expected_edges = 0) : num_nodes(num_nodes), is_built(false)
+  {
+    edge_froms.reserve(expected_edges);
+    edge_tos.reserve(expected_edges);
+    edge_capacities.reserve(expected_edges);
+  }
+
+  // add_edge adds an edge with the given capacity and returns its index
+  int add_edge(int from, int to, long capacity)
+  {
+    assert(!is_built);
+    assert(from >= 0 && from < num_nodes && to >= 0 && to < num_nodes && capacity >= 0);
+    edge_froms.push_back(from);
+    edge_tos.push_back(to);
+    edge_capacities.push_back(capacity);
+    return edge_froms.size() - 1;
+  }
+
+  // max_flow returns the value of a maximum flow from source to sink. Every call starts
+  // from an empty flow, so one network can be solved for several sources and sinks.
+  long max_flow(int source, int sink)
+  {
+    assert(source >= 0 && source < num_nodes && sink >= 0 && sink < num_nodes && source != sink);
+    build();
+    arc_residuals = arc_capacities;
+    long flow = 0;
+    while (compute_levels(source, sink))
+    {
+      next_arcs.assign(arc_offsets.begin(), arc_offsets.end() - 1);
+      while (long pushed = push_flow(source, sink, std::numeric_limits<long>::max()))
+      {
+        flow += pushed;
+      }
+    }
+    return flow;
+  }
+
+  // flow_on_edge returns how much of the last computed flow goes through edge
+  long flow_on_edge(int edge) const
+  {
+    int arc = edge_arcs.at(edge);
+    return arc_capacities.at(arc) - arc_residuals.at(arc);
+  }
+
+  // reachable_from returns which nodes can be reached from source along arcs with
+  // residual capacity. After max_flow(source, sink) this is the source side of a
+  // minimum cut.
+  std::vector<bool> reachable_from(int source) const
+  {
+    std::vector<bool> is_reachable(num_nodes, false);
+    std::vector<int> queue{source};
+    is_reachable.at(source) = true;
+    for (int i = 0; i < int(queue.size()); i++)
+    {
+      int node = queue[i];
+      for (int arc = arc_offsets[node]; arc < arc_offsets[node + 1]; arc++)
+      {
+        int next_node = arc_targets[arc];
+        if (arc_residuals[arc] > 0 && !is_reachable[next_node])
+        {
+          is_reachable[next_node] = true;
+          queue.push_back(next_node);
+        }
+      }
+    }
+    return is_reachable;
+  }
+
+  // cut_capacity returns the total capacity of the edges which go from a node with
+  // is_inside set to a node without
+  long cut_capacity(const std::vector<bool> &is_inside) const
+  {
+    long capacity = 0;
+    for (int i = 0; i < int(edge_froms.size()); i++)
+    {
+      if (is_inside.at(edge_froms[i]) && !is_inside.at(edge_tos[i]))
+      {
+        capacity += edge_capacities[i];
+      }
+    }
+    return capacity;
+  }
+
+private:
+  void build()
+  {
+    if (is_built)
+    {
+      return;
+    }
+    is_built = true;
+
+    int num_edges = edge_froms.size();
+    arc_offsets.assign(num_nodes + 1, 0);
+    for (int i = 0; i < num_edges; i++)
+    {
+      arc_offsets[edge_froms[i] + 1]++;
+      arc_offsets[edge_tos[i] + 1]++;
+    }
+    for (int node = 0; node < num_nodes; node++)
+    {
+      arc_offsets[node + 1] += arc_offsets[node];
+    }
+
+    arc_targets.resize(2 * num_edges);
+    arc_reverses.resize(2 * num_edges);
+    arc_capacities.resize(2 * num_edges);
+    edge_arcs.resize(num_edges);
+    std::vector<int> next_slots(arc_offsets.begin(), arc_offsets.end() - 1);
+    for (int i = 0; i < num_edges; i++)
+    {
+      int arc = next_slots[edge_froms[i]]++, reverse_arc = next_slots[edge_tos[i]]++;
+      arc_targets[arc] = edge_tos[i];
+      arc_targets[reverse_arc] = edge_froms[i];
+      arc_reverses[arc] = reverse_arc;
+      arc_reverses[reverse_arc] = arc;
+      arc_capacities[arc] = edge_capacities[i];
+      arc_capacities[reverse_arc] = 0;
+      edge_arcs[i] = arc;
+    }
+  }
+
+  // compute_levels sets levels to the BFS distance from source in the residual network
+  // and returns whether sink is reachable
+  bool compute_levels(int source, int sink)
+  {
+    levels.assign(num_nodes, -1);
+    queue.clear();
+    queue.push_back(source);
+    levels[source] = 0;
+    for (int i = 0; i < int(queue.size()) && levels[sink] == -1; i++)
+    {
+      int node = queue[i];
+      for (int arc = arc_offsets[node]; arc < arc_offsets[node + 1]; arc++)
+      {
+        int next_node = arc_targets[arc];
+        if (arc_residuals[arc] > 0 && levels[next_node] == -1)
+        {
+          levels[next_node] = levels[node] + 1;
+          queue.push_back(next_node);
+        }
+      }
+    }
+    return levels[sink] != -1;
+  }
+
+  // push_flow sends at most limit units along one path of increasing levels from node
+  // to sink and returns how much it sent. Arcs which can not lead to the sink anymore
+  // are skipped for the rest of the phase via next_arcs.
+  long push_flow(int node, int sink, long limit)
+  {
+    if (node == sink)
+    {
+      return limit;
+    }
+    for (int &arc = next_arcs[node]; arc < arc_offsets[node + 1]; arc++)
+    {
+      int next_node = arc_targets[arc];
+      if (arc_residuals[arc] > 0 && levels[next_node] == levels[node] + 1)
+      {
+        long pushed = push_flow(next_node, sink, std::min(limit, arc_residuals[arc]));
+        if (pushed > 0)
+        {
+          arc_residuals[arc] -= pushed;
+          arc_residuals[arc_reverses[arc]] += pushed;
+          return pushed;
+        }
+      }
+    }
+    return 0;
+  }
+
+  int num_nodes;
+  bool is_built;
+  std::vector<int> edge_froms, edge_tos, edge_arcs;
+  std::vector<long> edge_capacities;
+  std::vector<int> arc_offsets, arc_targets, arc_reverses, levels, queue, next_arcs;
+  std::vector<long> arc_capacities, arc_residuals;
+};
 
 template <typename T>
 void print_vec(std::vector<T> &vec, std::ostream &stream)
@@ -33,118 +215,171 @@ void print_vec(std::vector<T> &vec, std::ostream &stream)
   stream << "\n";
 }
 
-void testcase()
+// LowerBoundFlow decides whether there is a flow in which every edge carries between its
+// min and max capacity and every node sends out at most its supply more than it
+// receives (a negative supply is a demand that has to be met). Substituting the flow on
+// every edge by min + x turns this into one max flow on Network, which can be any type
+// with the add_edge, max_flow and flow_on_edge methods of FlowNetwork. All sums are
+// 64 bit.
+template <typename Network>
+class LowerBoundFlow
 {
-  int l, p;
-  std::cin >> l >> p;
-  assert(l >= 1 && l <= 500 && p >= 1 && p <= l * l);
-
-  std::vector<int> start_pops_by_town(l), end_pops_by_town(l);
-  int total_start_pops = 0, total_end_pops = 0;
-  for (int i = 0; i < l; i++)
+public:
+  explicit LowerBoundFlow(int num_nodes, int expected_edges = 0) : num_nodes(num_nodes), supplies(num_nodes, 0)
   {
-    int g, d;
-    std::cin >> g >> d;
-    assert(g >= 1 && g <= 1e6 && d >= 1 && d <= 1e6);
-    start_pops_by_town.at(i) = g;
-    total_start_pops += g;
-    end_pops_by_town.at(i) = d;
-    total_end_pops += d;
+    edge_froms.reserve(expected_edges);
+    edge_tos.reserve(expected_edges);
+    edge_mins.reserve(expected_edges);
+    edge_maxs.reserve(expected_edges);
   }
-  DEBUG(2, "total_start_pops " << total_start_pops << " total_end_pops " << total_end_pops);
 
-  std::vector<int> starts_by_path(p), ends_by_path(p), min_caps_by_path(p), max_caps_by_path(p);
-  for (int i = 0; i < p; i++)
-  {
-    int f, t, c, C;
-    std::cin >> f >> t >> c >> C;
-    assert(f >= 0 && f < l && t >= 0 && t < l);
-    assert(c >= 0 && c <= C && C <= 1e6);
-    starts_by_path.at(i) = f;
-    ends_by_path.at(i) = t;
-    min_caps_by_path.at(i) = c;
-    max_caps_by_path.at(i) = C;
-  }
-
-  if (total_end_pops > total_start_pops)
-  {
-    std::cout << "no\n";
-    return;
-  }
-
-  int num_nodes = l + p + 2, next_free_node = 0;
-  Vertex source = next_free_node++;
-  Vertex sink = next_free_node++;
-  auto town_at = [l, next_free_node](int i) { assert(i >= 0 && i < l);  return next_free_node + i; };
-  next_free_node += l;
-  auto path_mid_node_at = [p, next_free_node](int i) { assert(i >= 0 && i < p);  return next_free_node + i; };
-  next_free_node += p;
-  assert(next_free_node == num_nodes);
-  Graph G(num_nodes);
-
-  auto add_edge = [&G](int from, int to, long capacity) {
-    auto c_map = boost::get(boost::edge_capacity, G);
-    auto r_map = boost::get(boost::edge_reverse, G);
-    const auto e = boost::add_edge(from, to, G).first;
-    const auto rev_e = boost::add_edge(to, from, G).first;
-    c_map[e] = capacity;
-    c_map[rev_e] = 0;
-    r_map[e] = rev_e;
-    r_map[rev_e] = e;
-  };
-
-  std::vector<int> demands_by_town(l);
-  for (int i = 0; i < l; i++)
+  void add_supply(int node, long supply)
   {
-    demands_by_town.at(i) = end_pops_by_town.at(i) - start_pops_by_town.at(i);
+    supplies.at(node) += supply;
   }
-  if (debug_level >= 2)
+
+  // add_edge adds an edge which must carry between min_capacity and max_capacity and
+  // returns its index
+  int add_edge(int from, int to, long min_capacity, long max_capacity)
   {
-    std::cerr << "demands_by_town before adjustment ";
-    print_vec(demands_by_town, std::cerr);
+    assert(from >= 0 && from < num_nodes && to >= 0 && to < num_nodes);
+    assert(min_capacity >= 0 && min_capacity <= max_capacity);
+    edge_froms.push_back(from);
+    edge_tos.push_back(to);
+    edge_mins.push_back(min_capacity);
+    edge_maxs.push_back(max_capacity);
+    return edge_froms.size() - 1;
   }
 
-  for (int i = 0; i < p; i++)
+  // solve returns whether a feasible flow exists. If it does, flow_on_edge returns the
+  // flow of one feasible solution.
+  bool solve()
   {
-    int s = starts_by_path.at(i), e = ends_by_path.at(i), mid = path_mid_node_at(i), min = min_caps_by_path.at(i), max = max_caps_by_path.at(i);
-    demands_by_town.at(s) += min;
-    demands_by_town.at(e) -= min;
-    add_edge(town_at(s), mid, max - min);
-    add_edge(mid, town_at(e), max - min);
+    int num_edges = edge_froms.size();
+    long total_supply = 0;
+    std::vector<long> reduced_supplies = supplies;
+    for (int i = 0; i < num_edges; i++)
+    {
+      reduced_supplies.at(edge_froms[i]) -= edge_mins[i];
+      reduced_supplies.at(edge_tos[i]) += edge_mins[i];
+    }
+    for (long supply : supplies)
+    {
+      total_supply += supply;
+    }
+    DEBUG(2, "total_supply " << total_supply);
+    if (total_supply < 0)
+    {
+      return false;
+    }
+
+    const int source = num_nodes, sink = num_nodes + 1;
+    Network network(num_nodes + 2, num_edges + num_nodes);
+    std::vector<int> network_edges(num_edges);
+    for (int i = 0; i < num_edges; i++)
+    {
+      network_edges[i] = network.add_edge(edge_froms[i], edge_tos[i], edge_maxs[i] - edge_mins[i]);
+    }
+    long total_demand = 0;
+    for (int node = 0; node < num_nodes; node++)
+    {
+      long supply = reduced_supplies.at(node);
+      if (supply > 0)
+      {
+        network.add_edge(source, node, supply);
+      }
+      else if (supply < 0)
+      {
+        network.add_edge(node, sink, -supply);
+        total_demand -= supply;
+      }
+    }
+    DEBUG(2, "total_demand " << total_demand);
+
+    long flow = network.max_flow(source, sink);
+    DEBUG(2, "flow " << flow);
+    assert(flow >= 0 && flow <= total_demand);
+    if (flow < total_demand)
+    {
+      return false;
+    }
+
+    edge_flows.resize(num_edges);
+    for (int i = 0; i < num_edges; i++)
+    {
+      edge_flows[i] = edge_mins[i] + network.flow_on_edge(network_edges[i]);
+    }
+    if (debug_level >= 1)
+    {
+      assert_feasible();
+    }
+    return true;
   }
-  if (debug_level >= 2)
+
+  long flow_on_edge(int edge) const
   {
-    std::cerr << "demands_by_town after adjustment ";
-    print_vec(demands_by_town, std::cerr);
+    return edge_flows.at(edge);
   }
 
-  for (int i = 0; i < l; i++)
+private:
+  void assert_feasible() const
   {
-    int d = demands_by_town.at(i);
-    if (d > 0)
+    std::vector<long> net_outflows(num_nodes, 0);
+    for (int i = 0; i < int(edge_froms.size()); i++)
     {
-      add_edge(town_at(i), sink, d);
+      assert(edge_flows[i] >= edge_mins[i] && edge_flows[i] <= edge_maxs[i]);
+      net_outflows.at(edge_froms[i]) += edge_flows[i];
+      net_outflows.at(edge_tos[i]) -= edge_flows[i];
     }
-    else if (d < 0)
+    for (int node = 0; node < num_nodes; node++)
     {
-      add_edge(source, town_at(i), -d);
+      assert(net_outflows.at(node) <= supplies.at(node));
     }
   }
 
-  int target_flow = 0;
-  for (int d : demands_by_town)
+  int num_nodes;
+  std::vector<long> supplies;
+  std::vector<int> edge_froms, edge_tos;
+  std::vector<long> edge_mins, edge_maxs, edge_flows;
+};
+
+void testcase()
+{
+  int l, p;
+  std::cin >> l >> p;
+  assert(l >= 1 && l <= 500 && p >= 1 && p <= l * l);
+
+  // soldiers move along paths between towns, every town may keep any surplus
+  LowerBoundFlow<FlowNetwork> flow(l, p);
+  for (int i = 0; i < l; i++)
+  {
+    int g, d;
+    std::cin >> g >> d;
+    assert(g >= 1 && g <= 1e6 && d >= 1 && d <= 1e6);
+    flow.add_supply(i, g - d);
+  }
+
+  for (int i = 0; i < p; i++)
+  {
+    int f, t, c, C;
+    std::cin >> f >> t >> c >> C;
+    assert(f >= 0 && f < l && t >= 0 && t < l);
+    assert(c >= 0 && c <= C && C <= 1e6);
+    flow.add_edge(f, t, c, C);
+  }
+
+  bool is_feasible = flow.solve();
+  if (is_feasible && debug_level >= 3)
   {
-    if (d > 0)
+    std::vector<long> path_flows(p);
+    for (int i = 0; i < p; i++)
     {
-      target_flow += d;
+      path_flows.at(i) = flow.flow_on_edge(i);
     }
+    std::cerr << "path_flows ";
+    print_vec(path_flows, std::cerr);
   }
-  DEBUG(2, "target_flow " << target_flow);
-
-  long flow = boost::push_relabel_max_flow(G, source, sink);
-  DEBUG(2, "flow " << flow);
-  assert(flow >= 0 && flow <= target_flow);
-  std::cout << (flow == target_flow ? "yes\n" : "no\n");
+  std::cout << (is_feasible ? "yes\n" : "no\n");
 }
 
 int main()
@@ -0,0 +1,69 @@
+const child_process = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+// paths are relative to this JS file
+// "../a-boost" is the same solution built from a revision that still uses boost::push_relabel_max_flow
+// Boards larger than 50x50 fail the input asserts, so for those build both binaries with -DNDEBUG.
+const ALGORITHMS = [
+  { name: "push-relabel", path: "../a-boost", env: {} },
+  { name: "csr", path: "../a", env: { KNIGHTS_FLOW_SOLVER: "csr" } },
+  { name: "grid", path: "../a", env: { KNIGHTS_FLOW_SOLVER: "grid" } },
+];
+
+function randomInt(min, max) {
+  return min + Math.floor(Math.random() * (max - min + 1));
+}
+
+// genWorstCaseInput returns t test cases on a size x size grid with a knight at every intersection
+function genWorstCaseInput(t, size) {
+  const lines = [`${t}`];
+  for (let i = 0; i < t; i++) {
+    const m = size;
+    const n = size;
+    lines.push(`${m} ${n} ${m * n} ${randomInt(1, 4)}`);
+    for (let x = 0; x < m; x++) {
+      for (let y = 0; y < n; y++) {
+        lines.push(`${x} ${y}`);
+      }
+    }
+  }
+  return lines.join("\n") + "\n";
+}
+
+function timeAlgorithm(algorithm, inputPath) {
+  const start = process.hrtime.bigint();
+  child_process.execSync(
+    `${path.join(__dirname, algorithm.path).replace(/ /g, "\\ ")} < ${inputPath}`,
+    {
+      stdio: ["ignore", "ignore", "inherit"],
+      env: { ...process.env, ...algorithm.env },
+    }
+  );
+  return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+function bench(t, size, runs) {
+  const inputPath = path.join(os.tmpdir(), `knights-bench-${t}-${size}.txt`);
+  fs.writeFileSync(inputPath, genWorstCaseInput(t, size));
+  for (const algorithm of ALGORITHMS) {
+    const times = [];
+    for (let i = 0; i < runs; i++) {
+      times.push(timeAlgorithm(algorithm, inputPath));
+    }
+    times.sort((a, b) => a - b);
+    console.log(
+      `t = ${t}, ${size}x${size}, ${algorithm.name}: median ${times[
+        Math.floor(runs / 2)
+      ].toFixed(1)} ms`
+    );
+  }
+  fs.unlinkSync(inputPath);
+}
+
+bench(10, 50, 5);
+if (process.argv.includes("--large")) {
+  bench(3, 100, 3);
+  bench(1, 200, 3);
+}
@@ -1,16 +1,479 @@
 #include <iostream>
 #include <cassert>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/push_relabel_max_flow.hpp>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
 
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS> GraphTraits;
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::no_property,
-                              boost::property<boost::edge_capacity_t, int,
-                                              boost::property<boost::edge_residual_capacity_t, int,
-                                                              boost::property<boost::edge_reverse_t, GraphTraits::edge_descriptor>>>>
-    Graph;
+// FlowNetwork is a directed flow network with a built-in max flow solver (Dinic's
+// algorithm). Edges are collected with add_edge into arrays reserved up front, and laid
+// out once in compressed sparse row form when the first flow is computed: the arcs
+// leaving node a are [arc_offsets[a], arc_offsets[a + 1]), and every arc stores the
+// index of its paired reverse arc. This avoids the allocation per arc and reverse arc
+// of a boost::adjacency_list.
+class FlowNetwork
+{
+public:
+  explicit FlowNetwork(int num_nodes, int expected_edges = 0) : num_nodes(num_nodes), is_built(false)
+  {
+    edge_froms.reserve(expected_edges);
+    edge_tos.reserve(expected_edges);
+    edge_capacities.reserve(expected_edges);
+  }
+
+  // add_edge adds an edge with the given capacity and returns its index
+  int add_edge(int from, int to, long capacity)
+  {
+    assert(!is_built);
+    assert(from >= 0 && from < num_nodes && to >= 0 && to < num_nodes && capacity >= 0);
+    edge_froms.push_back(from);
+    edge_tos.push_back(to);
+    edge_capacities.push_back(capacity);
+    return edge_froms.size() - 1;
+  }
+
+  // max_flow returns the value of a maximum flow from source to sink. Every call starts
+  // from an empty flow, so one network can be solved for several sources and sinks.
+  long max_flow(int source, int sink)
+  {
+    assert(source >= 0 && source < num_nodes && sink >= 0 && sink < num_nodes && source != sink);
+    build();
+    arc_residuals = arc_capacities;
+    long flow = 0;
+    while (compute_levels(source, sink))
+    {
+      next_arcs.assign(arc_offsets.begin(), arc_offsets.end() - 1);
+      while (long pushed = push_flow(source, sink, std::numeric_limits<long>::max()))
+      {
+        flow += pushed;
+      }
+    }
+    return flow;
+  }
+
+  // flow_on_edge returns how much of the last computed flow goes through edge
+  long flow_on_edge(int edge) const
+  {
+    int arc = edge_arcs.at(edge);
+    return arc_capacities.at(arc) - arc_residuals.at(arc);
+  }
+
+  // reachable_from returns which nodes can be reached from source along arcs with
+  // residual capacity. After max_flow(source, sink) this is the source side of a
+  // minimum cut.
+  std::vector<bool> reachable_from(int source) const
+  {
+    std::vector<bool> is_reachable(num_nodes, false);
+    std::vector<int> queue{source};
+    is_reachable.at(source) = true;
+    for (int i = 0; i < int(queue.size()); i++)
+    {
+      int node = queue[i];
+      for (int arc = arc_offsets[node]; arc < arc_offsets[node + 1]; arc++)
+      {
+        int next_node = arc_targets[arc];
+        if (arc_residuals[arc] > 0 && !is_reachable[next_node])
+        {
+          is_reachable[next_node] = true;
+          queue.push_back(next_node);
+        }
+      }
+    }
+    return is_reachable;
+  }
+
+  // cut_capacity returns the total capacity of the edges which go from a node with
+  // is_inside set to a node without
+  long cut_capacity(const std::vector<bool> &is_inside) const
+  {
+    long capacity = 0;
+    for (int i = 0; i < int(edge_froms.size()); i++)
+    {
+      if (is_inside.at(edge_froms[i]) && !is_inside.at(edge_tos[i]))
+      {
+        capacity += edge_capacities[i];
+      }
+    }
+    return capacity;
+  }
+
+private:
+  void build()
+  {
+    if (is_built)
+    {
+      return;
+    }
+    is_built = true;
+
+    int num_edges = edge_froms.size();
+    arc_offsets.assign(num_nodes + 1, 0);
+    for (int i = 0; i < num_edges; i++)
+    {
+      arc_offsets[edge_froms[i] + 1]++;
+      arc_offsets[edge_tos[i] + 1]++;
+    }
+    for (int node = 0; node < num_nodes; node++)
+    {
+      arc_offsets[node + 1] += arc_offsets[node];
+    }
+
+    arc_targets.resize(2 * num_edges);
+    arc_reverses.resize(2 * num_edges);
+    arc_capacities.resize(2 * num_edges);
+    edge_arcs.resize(num_edges);
+    std::vector<int> next_slots(arc_offsets.begin(), arc_offsets.end() - 1);
+    for (int i = 0; i < num_edges; i++)
+    {
+      int arc = next_slots[edge_froms[i]]++, reverse_arc = next_slots[edge_tos[i]]++;
+      arc_targets[arc] = edge_tos[i];
+      arc_targets[reverse_arc] = edge_froms[i];
+      arc_reverses[arc] = reverse_arc;
+      arc_reverses[reverse_arc] = arc;
+      arc_capacities[arc] = edge_capacities[i];
+      arc_capacities[reverse_arc] = 0;
+      edge_arcs[i] = arc;
+    }
+  }
 
-void testcase()
+  // compute_levels sets levels to the BFS distance from source in the residual network
+  // and returns whether sink is reachable
+  bool compute_levels(int source, int sink)
+  {
+    levels.assign(num_nodes, -1);
+    queue.clear();
+    queue.push_back(source);
+    levels[source] = 0;
+    for (int i = 0; i < int(queue.size()) && levels[sink] == -1; i++)
+    {
+      int node = queue[i];
+      for (int arc = arc_offsets[node]; arc < arc_offsets[node + 1]; arc++)
+      {
+        int next_node = arc_targets[arc];
+        if (arc_residuals[arc] > 0 && levels[next_node] == -1)
+        {
+          levels[next_node] = levels[node] + 1;
+          queue.push_back(next_node);
+        }
+      }
+    }
+    return levels[sink] != -1;
+  }
+
+  // push_flow sends at most limit units along one path of increasing levels from node
+  // to sink and returns how much it sent. Arcs which can not lead to the sink anymore
+  // are skipped for the rest of the phase via next_arcs.
+  long push_flow(int node, int sink, long limit)
+  {
+    if (node == sink)
+    {
+      return limit;
+    }
+    for (int &arc = next_arcs[node]; arc < arc_offsets[node + 1]; arc++)
+    {
+      int next_node = arc_targets[arc];
+      if (arc_residuals[arc] > 0 && levels[next_node] == levels[node] + 1)
+      {
+        long pushed = push_flow(next_node, sink, std::min(limit, arc_residuals[arc]));
+        if (pushed > 0)
+        {
+          arc_residuals[arc] -= pushed;
+          arc_residuals[arc_reverses[arc]] += pushed;
+          return pushed;
+        }
+      }
+    }
+    return 0;
+  }
+
+  int num_nodes;
+  bool is_built;
+  std::vector<int> edge_froms, edge_tos, edge_arcs;
+  std::vector<long> edge_capacities;
+  std::vector<int> arc_offsets, arc_targets, arc_reverses, levels, queue, next_arcs;
+  std::vector<long> arc_capacities, arc_residuals;
+};
+
+// GridFlowNetwork is the knights network without stored edges. Nodes are numbered like
+// in testcase, and the arcs at a node are computed from its (col, row) or hall
+// coordinates when they are visited. Only the flow on every edge is stored, since
+// capacities follow from the edge's kind (c inside intersections, the number of knights
+// from the source, 1 everywhere else). Max flows are computed with Dinic's algorithm,
+// which on this unit-capacity network needs few phases.
+class GridFlowNetwork
+{
+public:
+  GridFlowNetwork(int m, int n, int c, const std::vector<int> &knights_by_intersection)
+      : m(m), n(n), c(c), knights_by_intersection(knights_by_intersection)
+  {
+    assert(int(knights_by_intersection.size()) == m * n);
+    num_nodes = 2 + 2 * m * n + m * (n + 1) + n * (m + 1);
+    flows.assign(10 * m * n + 2 * m + 2 * n, 0);
+  }
+
+  int max_flow()
+  {
+    int flow = 0;
+    while (compute_levels())
+    {
+      next_slots.assign(num_nodes, 0);
+      while (int pushed = push_flow(source_node, std::numeric_limits<int>::max()))
+      {
+        flow += pushed;
+      }
+    }
+    return flow;
+  }
+
+private:
+  // Arc is one direction of an edge: forward arcs have the edge's capacity minus its
+  // flow left, backward arcs can undo the flow
+  struct Arc
+  {
+    int edge, target;
+    bool forward;
+  };
+
+  enum
+  {
+    source_node = 0,
+    sink_node = 1,
+  };
+
+  // edge indices, each kind of edge is stored in its own block of flows
+  int source_edge(int col, int row) const { return col * n + row; }
+  int intersection_edge(int col, int row) const { return m * n + col * n + row; }
+  int col_out_edge(int col, int i, int side) const { return 2 * m * n + 2 * (col * n + i) + side; }
+  int col_in_edge(int col, int i, int side) const { return 4 * m * n + 2 * (col * n + i) + side; }
+  int row_out_edge(int row, int i, int side) const { return 6 * m * n + 2 * (row * m + i) + side; }
+  int row_in_edge(int row, int i, int side) const { return 8 * m * n + 2 * (row * m + i) + side; }
+  int col_sink_edge(int col, int end) const { return 10 * m * n + 2 * col + end; }
+  int row_sink_edge(int row, int end) const { return 10 * m * n + 2 * m + 2 * row + end; }
+
+  // node indices, the same as in testcase
+  int intersection_node(int col, int row, bool source_part) const { return 2 + 2 * (col * n + row) + (source_part ? 1 : 0); }
+  int col_hall_node(int col, int hall) const { return 2 + 2 * m * n + col * (n + 1) + hall; }
+  int row_hall_node(int row, int hall) const { return 2 + 2 * m * n + m * (n + 1) + row * (m + 1) + hall; }
+
+  int capacity(int edge) const
+  {
+    if (edge < m * n)
+    {
+      return knights_by_intersection[edge];
+    }
+    return edge < 2 * m * n ? c : 1;
+  }
+
+  int residual(const Arc &arc) const
+  {
+    return arc.forward ? capacity(arc.edge) - flows[arc.edge] : flows[arc.edge];
+  }
+
+  // arc_at sets arc to the arc in the given slot of node and returns false once there
+  // are no more slots. Slots which don't exist at the border get an edge of -1.
+  bool arc_at(int node, int slot, Arc &arc) const
+  {
+    arc.edge = -1;
+    if (node == source_node)
+    {
+      if (slot >= m * n)
+      {
+        return false;
+      }
+      arc = {slot, intersection_node(slot / n, slot % n, true), true};
+      return true;
+    }
+    if (node == sink_node)
+    {
+      if (slot >= 2 * m + 2 * n)
+      {
+        return false;
+      }
+      if (slot < 2 * m)
+      {
+        arc = {col_sink_edge(slot / 2, slot % 2), col_hall_node(slot / 2, slot % 2 == 0 ? 0 : n), false};
+      }
+      else
+      {
+        int row = (slot - 2 * m) / 2, end = slot % 2;
+        arc = {row_sink_edge(row, end), row_hall_node(row, end == 0 ? 0 : m), false};
+      }
+      return true;
+    }
+
+    int index = node - 2;
+    if (index < 2 * m * n)
+    {
+      int col = index / 2 / n, row = index / 2 % n;
+      bool source_part = index % 2 == 1;
+      if (source_part)
+      {
+        switch (slot)
+        {
+        case 0:
+          arc = {intersection_edge(col, row), intersection_node(col, row, false), true};
+          return true;
+        case 1:
+          arc = {source_edge(col, row), source_node, false};
+          return true;
+        case 2:
+        case 3:
+          arc = {col_in_edge(col, row, slot - 2), col_hall_node(col, row + slot - 2), false};
+          return true;
+        case 4:
+        case 5:
+          arc = {row_in_edge(row, col, slot - 4), row_hall_node(row, col + slot - 4), false};
+          return true;
+        }
+        return false;
+      }
+      switch (slot)
+      {
+      case 0:
+        arc = {intersection_edge(col, row), intersection_node(col, row, true), false};
+        return true;
+      case 1:
+      case 2:
+        arc = {col_out_edge(col, row, slot - 1), col_hall_node(col, row + slot - 1), true};
+        return true;
+      case 3:
+      case 4:
+        arc = {row_out_edge(row, col, slot - 3), row_hall_node(row, col + slot - 3), true};
+        return true;
+      }
+      return false;
+    }
+
+    index -= 2 * m * n;
+    // a hall between intersections (line, hall - 1) and (line, hall) of a column or row
+    bool is_col = index < m * (n + 1);
+    int line, hall, length;
+    if (is_col)
+    {
+      line = index / (n + 1), hall = index % (n + 1), length = n;
+    }
+    else
+    {
+      index -= m * (n + 1);
+      line = index / (m + 1), hall = index % (m + 1), length = m;
+    }
+    const auto intersection_at = [this, is_col, line](int i, bool source_part) {
+      return is_col ? intersection_node(line, i, source_part) : intersection_node(i, line, source_part);
+    };
+    switch (slot)
+    {
+    case 0:
+      if (hall >= 1)
+      {
+        arc = {is_col ? col_in_edge(line, hall - 1, 1) : row_in_edge(line, hall - 1, 1), intersection_at(hall - 1, true), true};
+      }
+      return true;
+    case 1:
+      if (hall < length)
+      {
+        arc = {is_col ? col_in_edge(line, hall, 0) : row_in_edge(line, hall, 0), intersection_at(hall, true), true};
+      }
+      return true;
+    case 2:
+      if (hall >= 1)
+      {
+        arc = {is_col ? col_out_edge(line, hall - 1, 1) : row_out_edge(line, hall - 1, 1), intersection_at(hall - 1, false), false};
+      }
+      return true;
+    case 3:
+      if (hall < length)
+      {
+        arc = {is_col ? col_out_edge(line, hall, 0) : row_out_edge(line, hall, 0), intersection_at(hall, false), false};
+      }
+      return true;
+    case 4:
+    case 5:
+      if (hall == (slot == 4 ? 0 : length))
+      {
+        arc = {is_col ? col_sink_edge(line, slot - 4) : row_sink_edge(line, slot - 4), sink_node, true};
+      }
+      return true;
+    }
+    return false;
+  }
+
+  bool compute_levels()
+  {
+    levels.assign(num_nodes, -1);
+    queue.clear();
+    queue.push_back(source_node);
+    levels[source_node] = 0;
+    for (int i = 0; i < int(queue.size()) && levels[sink_node] == -1; i++)
+    {
+      int node = queue[i];
+      Arc arc;
+      for (int slot = 0; arc_at(node, slot, arc); slot++)
+      {
+        if (arc.edge != -1 && levels[arc.target] == -1 && residual(arc) > 0)
+        {
+          levels[arc.target] = levels[node] + 1;
+          queue.push_back(arc.target);
+        }
+      }
+    }
+    return levels[sink_node] != -1;
+  }
+
+  int push_flow(int node, int limit)
+  {
+    if (node == sink_node)
+    {
+      return limit;
+    }
+    Arc arc;
+    for (int &slot = next_slots[node]; arc_at(node, slot, arc); slot++)
+    {
+      if (arc.edge == -1 || levels[arc.target] != levels[node] + 1)
+      {
+        continue;
+      }
+      int arc_residual = residual(arc);
+      if (arc_residual == 0)
+      {
+        continue;
+      }
+      int pushed = push_flow(arc.target, std::min(limit, arc_residual));
+      if (pushed > 0)
+      {
+        flows[arc.edge] += arc.forward ? pushed : -pushed;
+        return pushed;
+      }
+    }
+    return 0;
+  }
+
+  int m, n, c, num_nodes;
+  const std::vector<int> &knights_by_intersection;
+  std::vector<int> flows, levels, queue, next_slots;
+};
+
+enum FlowSolver
+{
+  flow_solver_csr,
+  flow_solver_grid,
+};
+
+// flow_solver_from_env returns the backend selected by the KNIGHTS_FLOW_SOLVER
+// environment variable ("csr" or "grid"). The default is csr, which was faster in
+// bench.js because its arcs don't need to be decoded from node indices.
+FlowSolver flow_solver_from_env()
+{
+  const char *name = std::getenv("KNIGHTS_FLOW_SOLVER");
+  if (name == nullptr || std::string(name) == "csr")
+  {
+    return flow_solver_csr;
+  }
+  assert(std::string(name) == "grid");
+  return flow_solver_grid;
+}
+
+void testcase(FlowSolver flow_solver)
 {
   int m, n, k, c;
   std::cin >> m >> n >> k >> c;
@@ -18,44 +481,46 @@ void testcase()
   assert(k >= 0 && k <= m * n);
   assert(c >= 0 && c <= 4);
 
+  std::vector<int> knight_cols(k), knight_rows(k), knights_by_intersection(m * n, 0);
+  for (int i = 0; i < k; i++)
+  {
+    std::cin >> knight_cols.at(i) >> knight_rows.at(i);
+    assert(knight_cols.at(i) >= 0 && knight_cols.at(i) < m && knight_rows.at(i) >= 0 && knight_rows.at(i) < n);
+    knights_by_intersection.at(knight_cols.at(i) * n + knight_rows.at(i))++;
+  }
+
+  if (flow_solver == flow_solver_grid)
+  {
+    std::cout << GridFlowNetwork(m, n, c, knights_by_intersection).max_flow() << "\n";
+    return;
+  }
+
   int total_nodes = 2 + 2 * m * n + m * (n + 1) + n * (m + 1);
-  Graph G(total_nodes);
+  FlowNetwork network(total_nodes, 2 * (m + n) + 9 * m * n + k);
   int next_free_node = 0;
-  Graph::vertex_descriptor source_node = next_free_node++;
-  Graph::vertex_descriptor sink_node = next_free_node++;
-  auto node_from_intersection = [next_free_node, m, n](int col, int row, bool source_part) -> Graph::vertex_descriptor {
+  int source_node = next_free_node++;
+  int sink_node = next_free_node++;
+  auto node_from_intersection = [next_free_node, m, n](int col, int row, bool source_part) {
     assert(col >= 0 && col < m && row >= 0 && row < n);
     return next_free_node + 2 * (col * n + row) + (source_part ? 1 : 0);
   };
   next_free_node += 2 * m * n;
-  auto node_from_col_hall = [next_free_node, m, n](int col, int hall) -> Graph::vertex_descriptor {
+  auto node_from_col_hall = [next_free_node, m, n](int col, int hall) {
     assert(col >= 0 && col < m && hall >= 0 && hall <= n);
     return next_free_node + col * (n + 1) + hall;
   };
   next_free_node += m * (n + 1);
-  auto node_from_row_hall = [next_free_node, m, n](int row, int hall) -> Graph::vertex_descriptor {
+  auto node_from_row_hall = [next_free_node, m, n](int row, int hall) {
     assert(row >= 0 && row < n && hall >= 0 && hall <= m);
     return next_free_node + row * (m + 1) + hall;
   };
   next_free_node += n * (m + 1);
   assert(next_free_node == total_nodes);
 
-  auto capacity_map = boost::get(boost::edge_capacity, G);
-  auto reverse_map = boost::get(boost::edge_reverse, G);
-  auto add_edge = [&G, &capacity_map, &reverse_map, total_nodes](int from, int to, int capacity) {
-    assert(from >= 0 && from < total_nodes && to >= 0 && to < total_nodes);
-    Graph::edge_descriptor e = boost::add_edge(from, to, G).first;
-    Graph::edge_descriptor rev_e = boost::add_edge(to, from, G).first;
-    capacity_map[e] = capacity;
-    capacity_map[rev_e] = 0;
-    reverse_map[e] = rev_e;
-    reverse_map[rev_e] = e;
-  };
-
   for (int col = 0; col < m; col++)
   {
-    add_edge(node_from_col_hall(col, 0), sink_node, 1);
-    add_edge(node_from_col_hall(col, n), sink_node, 1);
+    network.add_edge(node_from_col_hall(col, 0), sink_node, 1);
+    network.add_edge(node_from_col_hall(col, n), sink_node, 1);
     for (int i = 0; i < n; i++)
     {
       auto intersection_source = node_from_intersection(col, i, true);
@@ -63,16 +528,16 @@ void testcase()
       for (int hall : {i, i + 1})
       {
         auto hall_node = node_from_col_hall(col, hall);
-        add_edge(hall_node, intersection_source, 1);
-        add_edge(intersection_target, hall_node, 1);
+        network.add_edge(hall_node, intersection_source, 1);
+        network.add_edge(intersection_target, hall_node, 1);
       }
     }
   }
 
   for (int row = 0; row < n; row++)
   {
-    add_edge(node_from_row_hall(row, 0), sink_node, 1);
-    add_edge(node_from_row_hall(row, m), sink_node, 1);
+    network.add_edge(node_from_row_hall(row, 0), sink_node, 1);
+    network.add_edge(node_from_row_hall(row, m), sink_node, 1);
     for (int i = 0; i < m; i++)
     {
       auto intersection_source = node_from_intersection(i, row, true);
@@ -80,8 +545,8 @@ void testcase()
       for (int hall : {i, i + 1})
       {
         auto hall_node = node_from_row_hall(row, hall);
-        add_edge(hall_node, intersection_source, 1);
-        add_edge(intersection_target, hall_node, 1);
+        network.add_edge(hall_node, intersection_source, 1);
+        network.add_edge(intersection_target, hall_node, 1);
       }
     }
   }
@@ -90,19 +555,16 @@ void testcase()
   {
     for (int row = 0; row < n; row++)
     {
-      add_edge(node_from_intersection(col, row, true), node_from_intersection(col, row, false), c);
+      network.add_edge(node_from_intersection(col, row, true), node_from_intersection(col, row, false), c);
     }
   }
 
   for (int i = 0; i < k; i++)
   {
-    int x, y;
-    std::cin >> x >> y;
-    assert(x >= 0 && x < m && y >= 0 && y < n);
-    add_edge(source_node, node_from_intersection(x, y, true), 1);
+    network.add_edge(source_node, node_from_intersection(knight_cols.at(i), knight_rows.at(i), true), 1);
   }
 
-  int flow = boost::push_relabel_max_flow(G, source_node, sink_node);
+  int flow = network.max_flow(source_node, sink_node);
   std::cout << flow << "\n";
 }
 
@@ -112,9 +574,10 @@ int main()
 
   int t;
   std::cin >> t;
+  FlowSolver flow_solver = flow_solver_from_env();
   for (int i = 0; i < t; i++)
   {
-    testcase();
+    testcase(flow_solver);
   }
 
   return 0;
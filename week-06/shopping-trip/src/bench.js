@@ -0,0 +1,61 @@
+const child_process = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+// relative to this JS file
+// "../a-boost" is the same solution built from a revision that still uses boost::push_relabel_max_flow
+const COMPILED_ALGORITHM_PATHS = ["../a-boost", "../a"];
+
+function randomInt(min, max) {
+  return min + Math.floor(Math.random() * (max - min + 1));
+}
+
+// genWorstCaseInput returns t test cases with the most intersections, streets and stores
+function genWorstCaseInput(t) {
+  const lines = [`${t}`];
+  for (let i = 0; i < t; i++) {
+    const n = 1000;
+    const m = 5000;
+    const s = 10;
+    lines.push(`${n} ${m} ${s}`);
+    const stores = [];
+    for (let j = 0; j < s; j++) {
+      stores.push(randomInt(1, n - 1));
+    }
+    lines.push(stores.join(" "));
+    for (let j = 0; j < m; j++) {
+      lines.push(`${randomInt(0, n - 1)} ${randomInt(0, n - 1)}`);
+    }
+  }
+  return lines.join("\n") + "\n";
+}
+
+function timeAlgorithm(algorithmPath, inputPath) {
+  const start = process.hrtime.bigint();
+  child_process.execSync(
+    `${path.join(__dirname, algorithmPath).replace(/ /g, "\\ ")} < ${inputPath}`,
+    { stdio: ["ignore", "ignore", "inherit"] }
+  );
+  return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+function bench(t, runs) {
+  const inputPath = path.join(os.tmpdir(), `shopping-trip-bench-${t}.txt`);
+  fs.writeFileSync(inputPath, genWorstCaseInput(t));
+  for (const algorithmPath of COMPILED_ALGORITHM_PATHS) {
+    const times = [];
+    for (let i = 0; i < runs; i++) {
+      times.push(timeAlgorithm(algorithmPath, inputPath));
+    }
+    times.sort((a, b) => a - b);
+    console.log(
+      `t = ${t}, ${algorithmPath}: median ${times[Math.floor(runs / 2)].toFixed(
+        1
+      )} ms`
+    );
+  }
+  fs.unlinkSync(inputPath);
+}
+
+bench(20, 5);
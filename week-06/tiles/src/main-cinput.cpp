@@ -1,7 +1,7 @@
 #include <iostream>
 #include <cassert>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/max_cardinality_matching.hpp>
+#include <vector>
+#include <algorithm>
 
 const int debug_level = 0;
 
@@ -11,7 +11,248 @@ const int debug_level = 0;
     std::cerr << x << std::endl; \
   }
 
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+// DominoMatcher finds a maximum matching between neighboring free cells of a w x h
+// board with Hopcroft-Karp, in O(E sqrt(V)). Under checkerboard coloring every domino
+// covers one black cell ((x + y) even) and one white cell, so the grid graph is
+// bipartite. Cells of each color are stored in their own flat array, where the cell
+// (x, y) has index y * half_w + x / 2, and neighbors are computed from coordinates
+// instead of being stored.
+class DominoMatcher
+{
+public:
+  DominoMatcher(int w, int h) : w(w), h(h), half_w((w + 1) / 2), is_black_free(h * half_w, false), is_white_free(h * half_w, false) {}
+
+  void set_free(int x, int y)
+  {
+    assert(x >= 0 && x < w && y >= 0 && y < h);
+    ((x + y) % 2 == 0 ? is_black_free : is_white_free)[y * half_w + x / 2] = true;
+  }
+
+  // is_balanced returns whether there are as many free black cells as free white
+  // cells, which every tiling needs
+  bool is_balanced() const
+  {
+    return std::count(is_black_free.begin(), is_black_free.end(), true) == std::count(is_white_free.begin(), is_white_free.end(), true);
+  }
+
+  // max_matching returns the size of a maximum matching. With give_up_if_imperfect,
+  // it returns a smaller size as soon as it finds an unmatched black cell without an
+  // augmenting path: such a cell stays unmatched in every later matching too, so no
+  // perfect matching exists.
+  int max_matching(bool give_up_if_imperfect = false)
+  {
+    int num_black = h * half_w;
+    black_mates.assign(num_black, -1);
+    white_mates.assign(num_black, -1);
+    int matching_size = 0;
+
+    // a greedy matching leaves few cells for the phases
+    for (int black = 0; black < num_black; black++)
+    {
+      for (int direction = 0; direction < 4 && black_mates[black] == -1; direction++)
+      {
+        int white;
+        if (white_neighbor(black, direction, white) && white_mates[white] == -1)
+        {
+          black_mates[black] = white;
+          white_mates[white] = black;
+          matching_size++;
+        }
+      }
+    }
+
+    while (compute_distances())
+    {
+      next_directions.assign(num_black, 0);
+      int first_unmatched = -1;
+      for (int black = 0; black < num_black; black++)
+      {
+        if (is_black_free[black] && black_mates[black] == -1)
+        {
+          if (augment(black))
+          {
+            matching_size++;
+          }
+          else if (first_unmatched == -1)
+          {
+            first_unmatched = black;
+          }
+        }
+      }
+      if (give_up_if_imperfect && first_unmatched != -1 && !has_augmenting_path(first_unmatched))
+      {
+        break;
+      }
+    }
+    return matching_size;
+  }
+
+private:
+  // white_neighbor sets white to the neighbor of black in the given direction (0 to 3)
+  // and returns whether both cells exist and are free
+  bool white_neighbor(int black, int direction, int &white) const
+  {
+    if (!is_black_free[black])
+    {
+      return false;
+    }
+    int y = black / half_w, x = 2 * (black % half_w) + y % 2;
+    switch (direction)
+    {
+    case 0:
+      x--;
+      break;
+    case 1:
+      x++;
+      break;
+    case 2:
+      y--;
+      break;
+    default:
+      y++;
+    }
+    if (x < 0 || x >= w || y < 0 || y >= h)
+    {
+      return false;
+    }
+    white = y * half_w + x / 2;
+    return is_white_free[white];
+  }
+
+  // compute_distances sets the BFS layer of every black cell, starting from the
+  // unmatched ones and going through a white neighbor and its mate, and returns
+  // whether some unmatched white cell can be reached. last_distance becomes the layer
+  // of the black cells next to the closest unmatched white cells.
+  bool compute_distances()
+  {
+    int num_black = h * half_w;
+    distances.assign(num_black, unreached);
+    queue.clear();
+    for (int black = 0; black < num_black; black++)
+    {
+      if (is_black_free[black] && black_mates[black] == -1)
+      {
+        distances[black] = 0;
+        queue.push_back(black);
+      }
+    }
+
+    // only the shortest augmenting paths are used in a phase, so the search stops
+    // after the layer in which the first unmatched white cell is found
+    bool found_free_white = false;
+    for (int i = 0; i < int(queue.size()); i++)
+    {
+      int black = queue[i];
+      if (found_free_white && distances[black] > last_distance)
+      {
+        break;
+      }
+      last_distance = distances[black];
+      for (int direction = 0; direction < 4; direction++)
+      {
+        int white;
+        if (!white_neighbor(black, direction, white))
+        {
+          continue;
+        }
+        int next_black = white_mates[white];
+        if (next_black == -1)
+        {
+          found_free_white = true;
+        }
+        else if (distances[next_black] == unreached)
+        {
+          distances[next_black] = distances[black] + 1;
+          queue.push_back(next_black);
+        }
+      }
+    }
+    return found_free_white;
+  }
+
+  // has_augmenting_path returns whether an unmatched white cell can be reached from
+  // the unmatched black cell root along alternating paths
+  bool has_augmenting_path(int root)
+  {
+    distances.assign(h * half_w, unreached);
+    queue.assign(1, root);
+    distances[root] = 0;
+    for (int i = 0; i < int(queue.size()); i++)
+    {
+      int black = queue[i];
+      for (int direction = 0; direction < 4; direction++)
+      {
+        int white;
+        if (!white_neighbor(black, direction, white))
+        {
+          continue;
+        }
+        int next_black = white_mates[white];
+        if (next_black == -1)
+        {
+          return true;
+        }
+        if (distances[next_black] == unreached)
+        {
+          distances[next_black] = distances[black] + 1;
+          queue.push_back(next_black);
+        }
+      }
+    }
+    return false;
+  }
+
+  // augment searches an augmenting path from the unmatched black cell root along
+  // increasing distances, with an explicit stack so that huge boards can't overflow
+  // the call stack. If it finds one, it flips the path and returns true. Dead ends are
+  // marked as unreached for the rest of the phase.
+  bool augment(int root)
+  {
+    stack.assign(1, root);
+    while (!stack.empty())
+    {
+      int black = stack.back();
+      if (next_directions[black] == 4)
+      {
+        distances[black] = unreached;
+        stack.pop_back();
+        continue;
+      }
+      int white;
+      if (!white_neighbor(black, next_directions[black]++, white))
+      {
+        continue;
+      }
+      int next_black = white_mates[white];
+      if (next_black == -1 && distances[black] == last_distance)
+      {
+        // every black cell on the stack takes the white cell it went through
+        for (int path_black : stack)
+        {
+          int path_white;
+          white_neighbor(path_black, next_directions[path_black] - 1, path_white);
+          black_mates[path_black] = path_white;
+          white_mates[path_white] = path_black;
+        }
+        return true;
+      }
+      if (next_black != -1 && distances[next_black] == distances[black] + 1)
+      {
+        stack.push_back(next_black);
+      }
+    }
+    return false;
+  }
+
+  enum
+  {
+    unreached = -1,
+  };
+
+  int w, h, half_w, last_distance;
+  std::vector<bool> is_black_free, is_white_free;
+  std::vector<int> black_mates, white_mates, distances, next_directions, queue, stack;
+};
 
 bool char_is_tile(int c)
 {
@@ -43,11 +284,10 @@ void testcase()
 {
   int w, h;
   assert(scanf("%d%d", &w, &h) == 2);
-  assert(w >= 1 && w <= 50 && h >= 1 && h <= 50);
+  assert(w >= 1 && h >= 1 && long(w) * h <= (1 << 28));
   take_useless();
 
-  std::vector<std::vector<bool>> should_tile_at_cell(h, std::vector<bool>(w, false));
-  int num_nodes = w * h;
+  DominoMatcher matcher(w, h);
   int num_nodes_to_cover = 0;
   for (int y = 0; y < h; y++)
   {
@@ -56,51 +296,20 @@ void testcase()
       if (take_is_tile_char())
       {
         num_nodes_to_cover++;
-        should_tile_at_cell.at(y).at(x) = true;
+        matcher.set_free(x, y);
       }
     }
     take_useless();
   }
 
-  if (num_nodes_to_cover % 2 != 0)
+  if (num_nodes_to_cover % 2 != 0 || !matcher.is_balanced())
   {
     DEBUG(2, "fast path");
     printf("no\n");
     return;
   }
 
-  Graph G(num_nodes);
-  auto node_at_y_x = [w, h, num_nodes](int y, int x) -> Graph::vertex_descriptor {
-    assert(x >= 0 && x < w && y >= 0 && y < h);
-    int node = y * w + x;
-    assert(node >= 0 && node < num_nodes);
-    return node;
-  };
-
-  for (int y = 0; y < h; y++)
-  {
-    for (int x = 0; x < w; x++)
-    {
-      if (!should_tile_at_cell.at(y).at(x))
-      {
-        continue;
-      }
-      if (y > 0 && should_tile_at_cell.at(y - 1).at(x))
-      {
-        DEBUG(3, "adding vertical edge " << y << " " << x);
-        boost::add_edge(node_at_y_x(y - 1, x), node_at_y_x(y, x), G);
-      }
-      if (x > 0 && should_tile_at_cell.at(y).at(x - 1))
-      {
-        DEBUG(3, "adding horizontal edge " << y << " " << x);
-        boost::add_edge(node_at_y_x(y, x - 1), node_at_y_x(y, x), G);
-      }
-    }
-  }
-
-  std::vector<Graph::vertex_descriptor> mate(num_nodes);
-  assert(boost::checked_edmonds_maximum_cardinality_matching(G, mate.data()));
-  int num_nodes_covered = 2 * boost::matching_size(G, mate.data());
+  int num_nodes_covered = 2 * matcher.max_matching(true);
   DEBUG(2, "num_nodes_covered " << num_nodes_covered);
   assert(num_nodes_covered >= 0 && num_nodes_covered <= num_nodes_to_cover);
   printf(num_nodes_covered == num_nodes_to_cover ? "yes\n" : "no\n");
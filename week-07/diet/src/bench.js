@@ -0,0 +1,71 @@
+const child_process = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+// paths are relative to this JS file
+// Build with debug_level >= 1 to also see how many programs were certified.
+const ALGORITHMS = [
+  { name: "exact", path: "../a", env: { LP_SOLVER: "exact" } },
+  { name: "filtered", path: "../a", env: { LP_SOLVER: "filtered" } },
+];
+
+function randomInt(min, max) {
+  return min + Math.floor(Math.random() * (max - min + 1));
+}
+
+// genWorstCaseInput returns t test cases with the most nutrients and foods. The bounds
+// are chosen so that most of them matter and a diet exists.
+function genWorstCaseInput(t) {
+  const lines = [];
+  for (let i = 0; i < t; i++) {
+    const n = 40;
+    const m = 100;
+    lines.push(`${n} ${m}`);
+    for (let j = 0; j < n; j++) {
+      const min = randomInt(1 << 20, 1 << 23);
+      lines.push(`${min} ${min + randomInt(1 << 22, 1 << 26)}`);
+    }
+    for (let j = 0; j < m; j++) {
+      const values = [randomInt(0, (1 << 20) - 1)];
+      for (let k = 0; k < n; k++) {
+        values.push(randomInt(0, 1 << 19));
+      }
+      lines.push(values.join(" "));
+    }
+  }
+  lines.push("0 0");
+  return lines.join("\n") + "\n";
+}
+
+function timeAlgorithm(algorithm, inputPath) {
+  const start = process.hrtime.bigint();
+  child_process.execSync(
+    `${path.join(__dirname, algorithm.path).replace(/ /g, "\\ ")} < ${inputPath}`,
+    {
+      stdio: ["ignore", "ignore", "inherit"],
+      env: { ...process.env, ...algorithm.env },
+    }
+  );
+  return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+function bench(t, runs) {
+  const inputPath = path.join(os.tmpdir(), `diet-bench-${t}.txt`);
+  fs.writeFileSync(inputPath, genWorstCaseInput(t));
+  for (const algorithm of ALGORITHMS) {
+    const times = [];
+    for (let i = 0; i < runs; i++) {
+      times.push(timeAlgorithm(algorithm, inputPath));
+    }
+    times.sort((a, b) => a - b);
+    console.log(
+      `t = ${t}, n = 40, m = 100, ${algorithm.name}: median ${times[
+        Math.floor(runs / 2)
+      ].toFixed(1)} ms`
+    );
+  }
+  fs.unlinkSync(inputPath);
+}
+
+bench(10, 3);
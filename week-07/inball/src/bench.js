@@ -0,0 +1,68 @@
+const child_process = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+// paths are relative to this JS file
+// Build with debug_level >= 1 to also see how many programs were certified.
+const ALGORITHMS = [
+  { name: "exact", path: "../a", env: { LP_SOLVER: "exact" } },
+  { name: "filtered", path: "../a", env: { LP_SOLVER: "filtered" } },
+];
+
+function randomInt(min, max) {
+  return min + Math.floor(Math.random() * (max - min + 1));
+}
+
+// genWorstCaseInput returns t test cases with the most constraints and dimensions. The
+// right hand sides are positive and the normals short, so the ball has a nonzero radius.
+function genWorstCaseInput(t) {
+  const lines = [];
+  for (let i = 0; i < t; i++) {
+    const n = 1000;
+    const d = 10;
+    lines.push(`${n}`, `${d}`);
+    for (let j = 0; j < n; j++) {
+      const values = [];
+      for (let k = 0; k < d; k++) {
+        values.push(randomInt(-16, 16));
+      }
+      values.push(randomInt(512, 1024));
+      lines.push(values.join(" "));
+    }
+  }
+  lines.push("0");
+  return lines.join("\n") + "\n";
+}
+
+function timeAlgorithm(algorithm, inputPath) {
+  const start = process.hrtime.bigint();
+  child_process.execSync(
+    `${path.join(__dirname, algorithm.path).replace(/ /g, "\\ ")} < ${inputPath}`,
+    {
+      stdio: ["ignore", "ignore", "inherit"],
+      env: { ...process.env, ...algorithm.env },
+    }
+  );
+  return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+function bench(t, runs) {
+  const inputPath = path.join(os.tmpdir(), `inball-bench-${t}.txt`);
+  fs.writeFileSync(inputPath, genWorstCaseInput(t));
+  for (const algorithm of ALGORITHMS) {
+    const times = [];
+    for (let i = 0; i < runs; i++) {
+      times.push(timeAlgorithm(algorithm, inputPath));
+    }
+    times.sort((a, b) => a - b);
+    console.log(
+      `t = ${t}, n = 1000, d = 10, ${algorithm.name}: median ${times[
+        Math.floor(runs / 2)
+      ].toFixed(1)} ms`
+    );
+  }
+  fs.unlinkSync(inputPath);
+}
+
+bench(10, 3);
@@ -1,8 +1,9 @@
 #include <iostream>
 #include <cassert>
 #include <algorithm>
-#include <CGAL/QP_models.h>
-#include <CGAL/QP_functions.h>
+#include <array>
+#include <vector>
+#include <limits>
 #include <CGAL/Gmpz.h>
 
 const int debug_level = 0;
@@ -13,131 +14,383 @@ const int debug_level = 0;
     std::cerr << x << std::endl; \
   }
 
-typedef CGAL::Gmpz IT;
 typedef CGAL::Gmpz ET;
-typedef CGAL::Quadratic_program<IT> Program;
-typedef CGAL::Quadratic_program_solution<ET> Solution;
 
 const int max_dim = 30;
 const int space_dim = 3;
 const int not_found = -1;
 
-typedef std::vector<std::vector<std::vector<IT>>> PowCache;
-
 struct Point
 {
   std::array<int, space_dim> coords;
   bool healthy;
 };
 
-void add_dim_equations(Program &lp, int target_dim, int &next_free_var, std::vector<Point> &points, PowCache &pow_cache)
+ET int128_to_gmpz(__int128 value)
+{
+  if (value >= std::numeric_limits<long>::min() && value <= std::numeric_limits<long>::max())
+  {
+    return ET(long(value));
+  }
+  const bool is_negative = value < 0;
+  const unsigned __int128 magnitude = is_negative ? -(unsigned __int128)(value) : value;
+  const ET two_pow_32(long(1) << 32);
+  ET result = ET((unsigned long)(magnitude >> 64)) * two_pow_32 * two_pow_32 + ET((unsigned long)(magnitude));
+  return is_negative ? -result : result;
+}
+
+// ScaledSum adds up products of an ET and an __int128 or ET without converting the
+// __int128 to ET. The low and high 64 bits of each __int128 are multiplied into separate
+// sums, which are only combined in result.
+class ScaledSum
 {
-  std::vector<int> pows(space_dim, 0);
-  bool done = false;
-  while (!done)
+public:
+  ScaledSum() : low(0), high(0)
+  {
+  }
+
+  void add(const ET &factor, __int128 value)
+  {
+    const unsigned __int128 magnitude = value < 0 ? -(unsigned __int128)(value) : value;
+    const auto multiply_add = value < 0 ? mpz_submul_ui : mpz_addmul_ui;
+    multiply_add(low.mpz(), factor.mpz(), (unsigned long)(magnitude));
+    if (magnitude >> 64)
+    {
+      multiply_add(high.mpz(), factor.mpz(), (unsigned long)(magnitude >> 64));
+    }
+  }
+
+  void add(const ET &factor, const ET &value)
   {
-    for (int i = 0; i < space_dim; i++)
+    low += factor * value;
+  }
+
+  ET result() const
+  {
+    if (high == 0)
+    {
+      return low;
+    }
+    ET shifted_high;
+    mpz_mul_2exp(shifted_high.mpz(), high.mpz(), 64);
+    return shifted_high + low;
+  }
+
+private:
+  ET low, high;
+};
+
+// MonomialCache holds the value of every monomial added so far at every point, in one
+// flat array with a row per monomial. Each monomial is its parent of one degree lower
+// times one coordinate, so every value takes one multiplication. Values are __int128
+// while they fit and move to big_values on the first overflow.
+class MonomialCache
+{
+public:
+  explicit MonomialCache(const std::vector<Point> &points) : points(points), num_points(points.size())
+  {
+  }
+
+  // add_degree adds the monomials x^a y^b z^c with a + b + c = degree. Degrees have to
+  // be added in order, starting at 0.
+  void add_degree(int degree)
+  {
+    assert(degree == next_degree);
+    next_degree++;
+    if (degree == 0)
+    {
+      small_values.resize(num_points, 1);
+      big_value_indices.resize(num_points, not_found);
+      num_monomials++;
+      previous_indices = {0};
+      return;
+    }
+
+    // monomials of the previous degree are at previous_indices[a * degree + b]
+    std::vector<int> indices((degree + 1) * (degree + 1), not_found);
+    for (int a = degree; a >= 0; a--)
     {
-      int &v = pows.at(i);
-      if (v == target_dim)
+      for (int b = degree - a; b >= 0; b--)
       {
-        v = 0;
-        if (i + 1 == space_dim)
+        const int c = degree - a - b;
+        if (a > 0)
         {
-          done = true;
+          add_monomial(previous_indices.at((a - 1) * degree + b), 0);
         }
-      }
-      else
-      {
-        assert(v < target_dim);
-        v++;
-        break;
+        else if (b > 0)
+        {
+          add_monomial(previous_indices.at(b - 1), 1);
+        }
+        else
+        {
+          assert(c > 0);
+          add_monomial(previous_indices.at(0), 2);
+        }
+        indices.at(a * (degree + 1) + b) = num_monomials - 1;
       }
     }
+    previous_indices = std::move(indices);
+  }
 
-    int pow_sum = 0;
-    for (int i = 0; i < space_dim; i++)
+  int size() const
+  {
+    return num_monomials;
+  }
+
+  ET value(int monomial, int point) const
+  {
+    const int i = monomial * num_points + point;
+    const int big_index = big_value_indices[i];
+    return big_index == not_found ? int128_to_gmpz(small_values[i]) : big_values[big_index];
+  }
+
+  // add_scaled_value adds factor times the value of monomial at point to scaled_sum
+  void add_scaled_value(ScaledSum &scaled_sum, const ET &factor, int monomial, int point) const
+  {
+    const int i = monomial * num_points + point;
+    const int big_index = big_value_indices[i];
+    if (big_index == not_found)
     {
-      pow_sum += pows.at(i);
+      scaled_sum.add(factor, small_values[i]);
     }
-    if (pow_sum != target_dim)
+    else
     {
-      continue;
+      scaled_sum.add(factor, big_values[big_index]);
     }
+  }
 
-    for (int i = 0; i < int(points.size()); i++)
+private:
+  void add_monomial(int parent, int coord_index)
+  {
+    const int offset = num_monomials * num_points, parent_offset = parent * num_points;
+    small_values.resize(offset + num_points, 0);
+    big_value_indices.resize(offset + num_points, not_found);
+    for (int i = 0; i < num_points; i++)
     {
-      IT coef(1);
-      for (int j = 0; j < space_dim; j++)
+      const int coord = points[i].coords[coord_index];
+      const int parent_big_index = big_value_indices[parent_offset + i];
+      __int128 product;
+      if (parent_big_index == not_found && !__builtin_mul_overflow(small_values[parent_offset + i], coord, &product))
       {
-        coef *= pow_cache.at(i).at(j).at(pows.at(j));
+        small_values[offset + i] = product;
+        continue;
       }
-      lp.set_a(next_free_var, i, coef);
+      const ET parent_value = parent_big_index == not_found ? int128_to_gmpz(small_values[parent_offset + i]) : big_values[parent_big_index];
+      big_value_indices[offset + i] = big_values.size();
+      big_values.push_back(parent_value * coord);
     }
-
-    next_free_var++;
+    num_monomials++;
   }
-}
 
-bool solvable_with_dim(int target_dim, std::vector<Point> &points, PowCache &pow_cache)
+  const std::vector<Point> &points;
+  int num_points, num_monomials = 0, next_degree = 0;
+  std::vector<__int128> small_values;
+  std::vector<int> big_value_indices, previous_indices;
+  std::vector<ET> big_values;
+};
+
+// IncrementalFeasibilityProgram decides whether A x >= 1 has a solution with x free. It
+// is an exact phase 1 simplex with Bland's rule. Column k of A is monomial k of a
+// MonomialCache, with row i multiplied by row_signs[i], and the coefficients are read
+// from the cache instead of being copied. Monomials can be added to the cache between
+// calls to is_feasible. New columns start out nonbasic, so the basis of the previous
+// call stays feasible for phase 1 and the next call continues from it.
+//
+// The variables are numbered in Bland's order: artificial i is i, slack i is
+// num_rows + i, and column k is split into num_rows * 2 + 2 * k for +x_k and one more
+// for -x_k. The basis inverse is kept fraction free as inverse / determinant, where
+// both are integral because the basis is.
+class IncrementalFeasibilityProgram
 {
-  Program lp(CGAL::EQUAL, false, 0, false, 0);
-  auto lp_options = CGAL::Quadratic_program_options();
-  lp_options.set_pricing_strategy(CGAL::Quadratic_program_pricing_strategy::QP_BLAND);
+public:
+  IncrementalFeasibilityProgram(const MonomialCache &monomial_cache, const std::vector<int> &row_signs) : monomial_cache(monomial_cache), row_signs(row_signs), num_rows(row_signs.size()), basic_vars(num_rows), is_basic(2 * num_rows, false), inverse(num_rows, std::vector<ET>(num_rows, 0)), determinant(1), values(num_rows, 1)
+  {
+    // the artificial variables are the starting basis, so x = 0 and the slacks are 0
+    for (int i = 0; i < num_rows; i++)
+    {
+      basic_vars.at(i) = i;
+      is_basic.at(i) = true;
+      inverse.at(i).at(i) = 1;
+    }
+  }
 
-  int next_free_var = 0;
-  for (int i = 0; i <= target_dim; i++)
+  int num_columns() const
   {
-    add_dim_equations(lp, i, next_free_var, points, pow_cache);
+    return monomial_cache.size();
   }
 
-  for (int i = 0; i < int(points.size()); i++)
+  // is_feasible pivots until the artificial variables are all 0 or the phase 1
+  // objective (their sum) is optimal
+  bool is_feasible()
   {
-    Point &p = points.at(i);
-    lp.set_b(i, p.healthy ? -1 : 1);
-    lp.set_r(i, p.healthy ? CGAL::SMALLER : CGAL::LARGER);
+    is_basic.resize(2 * num_rows + 2 * num_columns(), false);
+    std::vector<ET> duals(num_rows), entering_column(num_rows), direction(num_rows);
+    while (true)
+    {
+      ET objective = 0;
+      std::fill(duals.begin(), duals.end(), ET(0));
+      for (int r = 0; r < num_rows; r++)
+      {
+        if (basic_vars.at(r) < num_rows)
+        {
+          objective += values.at(r);
+          for (int i = 0; i < num_rows; i++)
+          {
+            duals.at(i) += inverse.at(r).at(i);
+          }
+        }
+      }
+      if (objective == 0)
+      {
+        return true;
+      }
+
+      int entering = find_entering_var(duals);
+      DEBUG(3, "entering " << entering);
+      if (entering == not_found)
+      {
+        return false;
+      }
+
+      get_column(entering, entering_column);
+      for (int r = 0; r < num_rows; r++)
+      {
+        ET &d = direction.at(r);
+        d = 0;
+        for (int i = 0; i < num_rows; i++)
+        {
+          d += inverse.at(r).at(i) * entering_column.at(i);
+        }
+      }
+      int leaving_row = find_leaving_row(direction);
+      assert(leaving_row != not_found);
+      pivot(leaving_row, entering, direction);
+    }
   }
 
-  Solution solution = CGAL::solve_linear_program(lp, ET(), lp_options);
-  return !solution.is_infeasible();
-}
+private:
+  // find_entering_var returns the first var (in Bland's order) which has a negative
+  // reduced cost, ignoring artificial variables since they never have to re-enter.
+  // The reduced cost of a non-artificial var with column a is -duals * a / determinant.
+  int find_entering_var(const std::vector<ET> &duals) const
+  {
+    std::vector<ET> signed_duals(num_rows);
+    const int determinant_sign = determinant > 0 ? 1 : -1;
+    for (int i = 0; i < num_rows; i++)
+    {
+      if (!is_basic.at(num_rows + i) && -duals.at(i) * determinant_sign > 0)
+      {
+        return num_rows + i;
+      }
+      signed_duals.at(i) = row_signs.at(i) > 0 ? duals.at(i) : -duals.at(i);
+    }
+    for (int k = 0; k < num_columns(); k++)
+    {
+      const int var = 2 * num_rows + 2 * k;
+      if (is_basic.at(var) && is_basic.at(var + 1))
+      {
+        continue;
+      }
+      ScaledSum scaled_sum;
+      for (int i = 0; i < num_rows; i++)
+      {
+        monomial_cache.add_scaled_value(scaled_sum, signed_duals.at(i), k, i);
+      }
+      const ET product = scaled_sum.result();
+      const int sign = product > 0 ? determinant_sign : (product < 0 ? -determinant_sign : 0);
+      if (sign > 0 && !is_basic.at(var))
+      {
+        return var;
+      }
+      if (sign < 0 && !is_basic.at(var + 1))
+      {
+        return var + 1;
+      }
+    }
+    return not_found;
+  }
 
-int binary_search(int min_possible, int max_possible, std::function<bool(int)> is_target_or_higher)
-{
-  int low = min_possible, high = max_possible + 1;
-  int lowest_found_at = not_found;
-  while (low < high)
+  // find_leaving_row does the ratio test for the entering column, whose coordinates in
+  // the current basis are direction / determinant
+  int find_leaving_row(const std::vector<ET> &direction) const
   {
-    int i = (low + high) / 2;
-    if (is_target_or_higher(i))
+    const int determinant_sign = determinant > 0 ? 1 : -1;
+    int best_row = not_found;
+    for (int r = 0; r < num_rows; r++)
     {
-      high = i;
-      assert(lowest_found_at == not_found || lowest_found_at > i);
-      lowest_found_at = i;
+      const ET &d = direction.at(r);
+      if (d == 0 || (d > 0 ? 1 : -1) != determinant_sign)
+      {
+        continue;
+      }
+      if (best_row == not_found)
+      {
+        best_row = r;
+        continue;
+      }
+      // both directions have the same sign, so the cross products compare the ratios
+      // values[r] / d and values[best_row] / direction[best_row]
+      const ET lhs = values.at(r) * direction.at(best_row), rhs = values.at(best_row) * d;
+      if (lhs < rhs || (lhs == rhs && basic_vars.at(r) < basic_vars.at(best_row)))
+      {
+        best_row = r;
+      }
     }
-    else
+    return best_row;
+  }
+
+  // pivot replaces the basic var of row r. This is one fraction free Gauss-Jordan step,
+  // so the divisions by the old determinant are exact.
+  void pivot(int r, int entering, const std::vector<ET> &direction)
+  {
+    const ET &pivot_value = direction.at(r);
+    for (int i = 0; i < num_rows; i++)
     {
-      low = i + 1;
+      if (i == r)
+      {
+        continue;
+      }
+      const ET &factor = direction.at(i);
+      std::vector<ET> &row = inverse.at(i);
+      for (int j = 0; j < num_rows; j++)
+      {
+        row.at(j) = (pivot_value * row.at(j) - factor * inverse.at(r).at(j)) / determinant;
+      }
+      values.at(i) = (pivot_value * values.at(i) - factor * values.at(r)) / determinant;
     }
+    determinant = pivot_value;
+
+    is_basic.at(basic_vars.at(r)) = false;
+    is_basic.at(entering) = true;
+    basic_vars.at(r) = entering;
   }
-  return lowest_found_at;
-}
 
-// based on https://github.com/timethy/eth-16hs-algolab/blob/master/week12/radiation/radiation_robin.cpp
-int binary_search_fast(int min_possible, int max_possible, std::function<bool(int)> is_target_or_higher)
-{
-  int low = 1, high = 2;
-  while (high <= max_possible && !is_target_or_higher(high))
+  void get_column(int var, std::vector<ET> &column) const
   {
-    low = high + 1;
-    high *= 2;
+    if (var < 2 * num_rows)
+    {
+      std::fill(column.begin(), column.end(), ET(0));
+      column.at(var % num_rows) = var < num_rows ? 1 : -1;
+      return;
+    }
+    const int k = (var - 2 * num_rows) / 2;
+    const bool is_negated = (var - 2 * num_rows) % 2 == 1;
+    for (int i = 0; i < num_rows; i++)
+    {
+      const ET value = monomial_cache.value(k, i);
+      column.at(i) = (row_signs.at(i) > 0) != is_negated ? value : -value;
+    }
   }
-  high = std::min(high, max_possible);
-  low = std::min(low, high);
 
-  DEBUG(2, "low " << low << " high " << high);
-  return binary_search(low, high, is_target_or_higher);
-}
+  const MonomialCache &monomial_cache;
+  const std::vector<int> row_signs;
+  int num_rows;
+  std::vector<int> basic_vars;
+  std::vector<bool> is_basic;
+  std::vector<std::vector<ET>> inverse;
+  ET determinant;
+  std::vector<ET> values;
+};
 
 void testcase()
 {
@@ -166,26 +419,28 @@ void testcase()
     return;
   }
 
-  PowCache pow_cache(n, std::vector<std::vector<IT>>(space_dim, std::vector<IT>(max_dim + 1)));
+  // the row of a healthy point is negated, so that every row has to be >= 1
+  std::vector<int> row_signs(n);
   for (int i = 0; i < n; i++)
   {
-    for (int j = 0; j < space_dim; j++)
+    row_signs.at(i) = points.at(i).healthy ? -1 : 1;
+  }
+  MonomialCache monomial_cache(points);
+
+  // A polynomial of degree dim also has all monomials of the smaller degrees, so the
+  // degrees are tried in increasing order, each continuing from the previous basis.
+  IncrementalFeasibilityProgram lp(monomial_cache, row_signs);
+  int required_dims = not_found;
+  for (int dim = 0; dim <= max_dim; dim++)
+  {
+    monomial_cache.add_degree(dim);
+    DEBUG(2, "dim " << dim << " columns " << lp.num_columns());
+    if (dim >= 1 && lp.is_feasible())
     {
-      int coord = points.at(i).coords.at(j);
-      IT power(1);
-      pow_cache.at(i).at(j).at(0) = power;
-      for (int k = 1; k <= max_dim; k++)
-      {
-        power *= coord;
-        pow_cache.at(i).at(j).at(k) = power;
-      }
+      required_dims = dim;
+      break;
     }
   }
-
-  int required_dims = binary_search_fast(1, max_dim, [&points, &pow_cache](int i) {
-    DEBUG(2, "evaluated at " << i);
-    return solvable_with_dim(i, points, pow_cache);
-  });
   if (required_dims >= 0)
   {
     std::cout << required_dims << "\n";
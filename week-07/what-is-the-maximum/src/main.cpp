@@ -1,5 +1,9 @@
 #include <iostream>
 #include <cassert>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <vector>
 #include <CGAL/QP_models.h>
 #include <CGAL/QP_functions.h>
 #include <CGAL/Gmpz.h>
@@ -17,7 +21,592 @@ const int debug_level = 0;
     std::cerr << x << std::endl; \
   }
 
-void testcase(int p)
+enum LinearProgramStatus
+{
+  lp_infeasible,
+  lp_unbounded,
+  lp_optimal,
+};
+
+struct LinearProgramResult
+{
+  LinearProgramStatus status;
+  ET objective_numerator = 0, objective_denominator = 1;
+};
+
+enum LinearProgramSolver
+{
+  lp_solver_filtered,
+  lp_solver_exact,
+};
+
+// lp_solver_from_env returns the solver selected by the LP_SOLVER environment variable
+// ("filtered" or "exact"). The default is filtered.
+LinearProgramSolver lp_solver_from_env()
+{
+  const char *name = std::getenv("LP_SOLVER");
+  if (name == nullptr || std::string(name) == "filtered")
+  {
+    return lp_solver_filtered;
+  }
+  assert(std::string(name) == "exact");
+  return lp_solver_exact;
+}
+
+struct LinearProgramStats
+{
+  long certified_optimal = 0, certified_infeasible = 0, exact_fallbacks = 0;
+};
+
+LinearProgramStats lp_stats;
+
+void print_lp_stats()
+{
+  std::cerr << "certified_optimal " << lp_stats.certified_optimal << " certified_infeasible " << lp_stats.certified_infeasible
+            << " exact_fallbacks " << lp_stats.exact_fallbacks << "\n";
+}
+
+// FilteredLinearProgram minimizes c^T x subject to A x <= b, where every variable is
+// either free or nonnegative. The setters match the ones of CGAL::Quadratic_program.
+//
+// The filtered solver runs a dense tableau simplex in doubles and then certifies the
+// basis it stops at with Gmpz: the basic solution and the dual solution of that basis
+// are computed exactly, and if both are feasible the basis is optimal. Infeasibility is
+// certified the same way on the phase 1 program. Everything that can't be certified
+// (including unbounded programs) is solved again with CGAL::solve_linear_program.
+class FilteredLinearProgram
+{
+public:
+  void set_a(int variable, int constraint, IT value)
+  {
+    resize(variable + 1, constraint + 1);
+    a_by_constraint.at(constraint).at(variable) = value;
+  }
+
+  void set_b(int constraint, IT value)
+  {
+    resize(0, constraint + 1);
+    bs.at(constraint) = value;
+  }
+
+  void set_c(int variable, IT value)
+  {
+    resize(variable + 1, 0);
+    cs.at(variable) = value;
+  }
+
+  void set_nonnegative(int variable)
+  {
+    resize(variable + 1, 0);
+    is_nonnegative.at(variable) = true;
+  }
+
+  LinearProgramResult solve(LinearProgramSolver solver)
+  {
+    if (solver == lp_solver_filtered)
+    {
+      LinearProgramResult result;
+      if (solve_filtered(result))
+      {
+        return result;
+      }
+      lp_stats.exact_fallbacks++;
+    }
+    return solve_exact();
+  }
+
+private:
+  // artificial_column is the phase 1 variable, which has coefficient -1 in every
+  // constraint
+  enum
+  {
+    artificial_column = -1
+  };
+
+  void resize(int min_variables, int min_constraints)
+  {
+    int num_variables = std::max(int(cs.size()), min_variables);
+    int num_constraints = std::max(int(bs.size()), min_constraints);
+    cs.resize(num_variables, 0);
+    is_nonnegative.resize(num_variables, false);
+    bs.resize(num_constraints, 0);
+    a_by_constraint.resize(num_constraints);
+    for (std::vector<IT> &as : a_by_constraint)
+    {
+      as.resize(num_variables, 0);
+    }
+  }
+
+  LinearProgramResult solve_exact() const
+  {
+    Program lp(CGAL::SMALLER, false, 0, false, 0);
+    for (int i = 0; i < int(bs.size()); i++)
+    {
+      for (int j = 0; j < int(cs.size()); j++)
+      {
+        if (a_by_constraint[i][j] != 0)
+        {
+          lp.set_a(j, i, a_by_constraint[i][j]);
+        }
+      }
+      lp.set_b(i, bs[i]);
+    }
+    for (int j = 0; j < int(cs.size()); j++)
+    {
+      lp.set_c(j, cs[j]);
+      if (is_nonnegative[j])
+      {
+        lp.set_l(j, true, 0);
+      }
+    }
+
+    Solution s = CGAL::solve_linear_program(lp, ET());
+    LinearProgramResult result;
+    if (s.is_infeasible())
+    {
+      result.status = lp_infeasible;
+    }
+    else if (s.is_unbounded())
+    {
+      result.status = lp_unbounded;
+    }
+    else
+    {
+      assert(s.is_optimal());
+      result.status = lp_optimal;
+      result.objective_numerator = s.objective_value_numerator();
+      result.objective_denominator = s.objective_value_denominator();
+    }
+    return result;
+  }
+
+  // solve_filtered returns false if the double simplex result can't be certified
+  bool solve_filtered(LinearProgramResult &result)
+  {
+    // the tableau simplex wants max c^T x with x >= 0, so free variables are split
+    // into a positive and a negative column
+    column_variables.clear();
+    column_signs.clear();
+    for (int j = 0; j < int(cs.size()); j++)
+    {
+      column_variables.push_back(j);
+      column_signs.push_back(1);
+      if (!is_nonnegative[j])
+      {
+        column_variables.push_back(j);
+        column_signs.push_back(-1);
+      }
+    }
+
+    bool is_phase_1 = false;
+    LinearProgramStatus status = run_simplex(is_phase_1);
+    if (status == lp_unbounded)
+    {
+      return false;
+    }
+
+    std::vector<int> basic_columns, tight_constraints;
+    const int m = bs.size(), n = column_variables.size();
+    for (int i = 0; i < m; i++)
+    {
+      if (basic[i] >= 0 && basic[i] < n)
+      {
+        basic_columns.push_back(basic[i]);
+      }
+    }
+    for (int j = 0; j <= n; j++)
+    {
+      if (nonbasic[j] >= n)
+      {
+        tight_constraints.push_back(nonbasic[j] - n);
+      }
+    }
+
+    ET objective_numerator, objective_denominator;
+    if (!certify_basis(basic_columns, tight_constraints, is_phase_1, objective_numerator, objective_denominator))
+    {
+      return false;
+    }
+    if (status == lp_infeasible)
+    {
+      assert(is_phase_1);
+      // phase 1 maximizes -x_artificial, so an optimum below 0 proves infeasibility
+      if (objective_numerator >= 0)
+      {
+        return false;
+      }
+      lp_stats.certified_infeasible++;
+      result.status = lp_infeasible;
+      return true;
+    }
+    lp_stats.certified_optimal++;
+    result.status = lp_optimal;
+    result.objective_numerator = -objective_numerator;
+    result.objective_denominator = objective_denominator;
+    return true;
+  }
+
+  // column_cost returns the coefficient of column in the maximized objective
+  IT column_cost(int column, bool is_phase_1) const
+  {
+    if (is_phase_1)
+    {
+      return column == artificial_column ? -1 : 0;
+    }
+    assert(column != artificial_column);
+    return -column_signs[column] * cs[column_variables[column]];
+  }
+
+  // run_simplex is the two phase tableau simplex from the Stanford ACM notebook. The
+  // tableau has a row per constraint and a column per nonbasic variable, where
+  // variable j < n is column j, n + i is the slack of constraint i and -1 is the
+  // artificial variable. It leaves the final basis in basic and nonbasic, and sets
+  // is_phase_1 if it stopped in phase 1.
+  LinearProgramStatus run_simplex(bool &is_phase_1)
+  {
+    const int m = bs.size(), n = column_variables.size();
+    tableau.assign(m + 2, std::vector<double>(n + 2, 0));
+    basic.resize(m);
+    nonbasic.resize(n + 1);
+    for (int i = 0; i < m; i++)
+    {
+      for (int j = 0; j < n; j++)
+      {
+        tableau[i][j] = column_signs[j] * a_by_constraint[i][column_variables[j]];
+      }
+      basic[i] = n + i;
+      tableau[i][n] = -1;
+      tableau[i][n + 1] = bs[i];
+    }
+    for (int j = 0; j < n; j++)
+    {
+      nonbasic[j] = j;
+      tableau[m][j] = -column_cost(j, false);
+    }
+    nonbasic[n] = artificial_column;
+    tableau[m + 1][n] = 1;
+    max_pivots = 50 * (m + n + 1);
+
+    int r = 0;
+    for (int i = 1; i < m; i++)
+    {
+      if (tableau[i][n + 1] < tableau[r][n + 1])
+      {
+        r = i;
+      }
+    }
+    if (m > 0 && tableau[r][n + 1] < -eps)
+    {
+      pivot(r, n);
+      if (!run_phase(1))
+      {
+        return lp_unbounded;
+      }
+      if (tableau[m + 1][n + 1] < -eps)
+      {
+        is_phase_1 = true;
+        return lp_infeasible;
+      }
+      for (int i = 0; i < m; i++)
+      {
+        if (basic[i] == artificial_column)
+        {
+          int s = -1;
+          for (int j = 0; j <= n; j++)
+          {
+            if (s == -1 || tableau[i][j] < tableau[i][s] || (tableau[i][j] == tableau[i][s] && nonbasic[j] < nonbasic[s]))
+            {
+              s = j;
+            }
+          }
+          pivot(i, s);
+        }
+      }
+    }
+    if (!run_phase(2))
+    {
+      return lp_unbounded;
+    }
+    return lp_optimal;
+  }
+
+  // run_phase returns false if the phase is unbounded or runs out of pivots
+  bool run_phase(int phase)
+  {
+    const int m = bs.size(), n = column_variables.size();
+    const int objective_row = phase == 1 ? m + 1 : m;
+    const std::vector<double> &objective = tableau[objective_row];
+    while (true)
+    {
+      int s = -1;
+      for (int j = 0; j <= n; j++)
+      {
+        if (phase == 2 && nonbasic[j] == artificial_column)
+        {
+          continue;
+        }
+        if (s == -1 || objective[j] < objective[s] || (objective[j] == objective[s] && nonbasic[j] < nonbasic[s]))
+        {
+          s = j;
+        }
+      }
+      if (objective[s] > -eps)
+      {
+        return true;
+      }
+      int r = -1;
+      for (int i = 0; i < m; i++)
+      {
+        if (tableau[i][s] < eps)
+        {
+          continue;
+        }
+        if (r == -1)
+        {
+          r = i;
+          continue;
+        }
+        double ratio = tableau[i][n + 1] / tableau[i][s], best_ratio = tableau[r][n + 1] / tableau[r][s];
+        if (ratio < best_ratio || (ratio == best_ratio && basic[i] < basic[r]))
+        {
+          r = i;
+        }
+      }
+      if (r == -1 || max_pivots == 0)
+      {
+        return false;
+      }
+      pivot(r, s);
+    }
+  }
+
+  void pivot(int r, int s)
+  {
+    const int m = bs.size(), n = column_variables.size();
+    max_pivots--;
+    const double inverse = 1.0 / tableau[r][s];
+    const std::vector<double> &pivot_row = tableau[r];
+    for (int i = 0; i < m + 2; i++)
+    {
+      if (i != r && tableau[i][s] != 0)
+      {
+        const double factor = tableau[i][s] * inverse;
+        std::vector<double> &row = tableau[i];
+        for (int j = 0; j < n + 2; j++)
+        {
+          row[j] -= pivot_row[j] * factor;
+        }
+        row[s] = -factor;
+      }
+    }
+    for (int j = 0; j < n + 2; j++)
+    {
+      tableau[r][j] *= inverse;
+    }
+    tableau[r][s] = inverse;
+    std::swap(basic[r], nonbasic[s]);
+  }
+
+  // solve_exactly solves the square system matrix * x = rhs with fraction free
+  // Gauss-Jordan elimination. It returns false if matrix is singular, and otherwise
+  // x_i = numerators[i] / denominator with denominator > 0.
+  static bool solve_exactly(std::vector<std::vector<ET>> &matrix, std::vector<ET> &rhs, std::vector<ET> &numerators, ET &denominator)
+  {
+    const int k = rhs.size();
+    ET previous_pivot = 1;
+    for (int p = 0; p < k; p++)
+    {
+      int pivot_row = p;
+      while (pivot_row < k && matrix[pivot_row][p] == 0)
+      {
+        pivot_row++;
+      }
+      if (pivot_row == k)
+      {
+        return false;
+      }
+      std::swap(matrix[p], matrix[pivot_row]);
+      std::swap(rhs[p], rhs[pivot_row]);
+
+      const ET pivot = matrix[p][p];
+      for (int i = 0; i < k; i++)
+      {
+        if (i == p)
+        {
+          continue;
+        }
+        const ET factor = matrix[i][p];
+        for (int j = 0; j < k; j++)
+        {
+          if (j != p)
+          {
+            matrix[i][j] = (pivot * matrix[i][j] - factor * matrix[p][j]) / previous_pivot;
+          }
+        }
+        rhs[i] = (pivot * rhs[i] - factor * rhs[p]) / previous_pivot;
+        matrix[i][p] = 0;
+      }
+      previous_pivot = pivot;
+    }
+
+    // every diagonal entry is now the determinant
+    denominator = k == 0 ? ET(1) : matrix[0][0];
+    numerators = rhs;
+    if (denominator < 0)
+    {
+      denominator = -denominator;
+      for (ET &numerator : numerators)
+      {
+        numerator = -numerator;
+      }
+    }
+    return true;
+  }
+
+  // certify_basis checks in exact arithmetic that the basis given by its columns and the
+  // constraints whose slacks are nonbasic is optimal for max c^T x, and returns the
+  // objective value as a fraction
+  bool certify_basis(std::vector<int> basic_columns, const std::vector<int> &tight_constraints, bool is_phase_1, ET &objective_numerator, ET &objective_denominator) const
+  {
+    if (is_phase_1)
+    {
+      bool is_artificial_basic = false;
+      for (int i = 0; i < int(basic.size()); i++)
+      {
+        is_artificial_basic |= basic[i] == artificial_column;
+      }
+      if (is_artificial_basic)
+      {
+        basic_columns.push_back(artificial_column);
+      }
+    }
+    const int k = basic_columns.size();
+    if (int(tight_constraints.size()) != k)
+    {
+      return false;
+    }
+
+    // primal: the basic columns have to satisfy the tight constraints with equality
+    std::vector<std::vector<ET>> matrix(k, std::vector<ET>(k));
+    std::vector<ET> rhs(k), values;
+    ET value_denominator;
+    for (int i = 0; i < k; i++)
+    {
+      for (int j = 0; j < k; j++)
+      {
+        matrix[i][j] = coefficient(tight_constraints[i], basic_columns[j]);
+      }
+      rhs[i] = bs[tight_constraints[i]];
+    }
+    if (!solve_exactly(matrix, rhs, values, value_denominator))
+    {
+      return false;
+    }
+    for (const ET &value : values)
+    {
+      if (value < 0)
+      {
+        return false;
+      }
+    }
+    std::vector<bool> is_tight(bs.size(), false);
+    for (int constraint : tight_constraints)
+    {
+      is_tight[constraint] = true;
+    }
+    for (int i = 0; i < int(bs.size()); i++)
+    {
+      if (is_tight[i])
+      {
+        continue;
+      }
+      ET lhs = 0;
+      for (int j = 0; j < k; j++)
+      {
+        lhs += coefficient(i, basic_columns[j]) * values[j];
+      }
+      if (lhs > bs[i] * value_denominator)
+      {
+        return false;
+      }
+    }
+
+    // dual: the multipliers of the tight constraints have to be nonnegative and price
+    // every nonbasic column out
+    std::vector<ET> duals;
+    ET dual_denominator;
+    for (int i = 0; i < k; i++)
+    {
+      for (int j = 0; j < k; j++)
+      {
+        matrix[i][j] = coefficient(tight_constraints[j], basic_columns[i]);
+      }
+      rhs[i] = column_cost(basic_columns[i], is_phase_1);
+    }
+    if (!solve_exactly(matrix, rhs, duals, dual_denominator))
+    {
+      return false;
+    }
+    for (const ET &dual : duals)
+    {
+      if (dual < 0)
+      {
+        return false;
+      }
+    }
+    std::vector<bool> is_basic(column_variables.size() + 1, false);
+    for (int column : basic_columns)
+    {
+      is_basic[column + 1] = true;
+    }
+    for (int column = is_phase_1 ? artificial_column : 0; column < int(column_variables.size()); column++)
+    {
+      if (is_basic[column + 1])
+      {
+        continue;
+      }
+      ET reduced_cost = 0;
+      for (int i = 0; i < k; i++)
+      {
+        reduced_cost += coefficient(tight_constraints[i], column) * duals[i];
+      }
+      if (reduced_cost < column_cost(column, is_phase_1) * dual_denominator)
+      {
+        return false;
+      }
+    }
+
+    objective_numerator = 0;
+    for (int j = 0; j < k; j++)
+    {
+      objective_numerator += column_cost(basic_columns[j], is_phase_1) * values[j];
+    }
+    objective_denominator = value_denominator;
+    return true;
+  }
+
+  ET coefficient(int constraint, int column) const
+  {
+    if (column == artificial_column)
+    {
+      return -1;
+    }
+    return column_signs[column] * a_by_constraint[constraint][column_variables[column]];
+  }
+
+  static constexpr double eps = 1e-9;
+
+  std::vector<std::vector<IT>> a_by_constraint;
+  std::vector<IT> bs, cs;
+  std::vector<bool> is_nonnegative;
+
+  std::vector<int> column_variables, column_signs;
+  std::vector<std::vector<double>> tableau;
+  std::vector<int> basic, nonbasic;
+  int max_pivots;
+};
+
+void testcase(int p, LinearProgramSolver solver)
 {
   assert(p == 1 || p == 2);
 
@@ -25,12 +614,14 @@ void testcase(int p)
   std::cin >> a >> b;
   assert(a >= 0 && a <= 100 && b >= -100 && b <= 100);
 
-  Program lp = p == 1 ? Program(CGAL::SMALLER, true, 0, false, 0) : Program(CGAL::LARGER, false, 0, true, 0);
-
+  // For p == 2 all variables are <= 0 and all constraints are >=, so we solve for
+  // (-x, -y, -z) instead, which turns both around.
+  FilteredLinearProgram lp;
   const IT X = 0, Y = 1, Z = 2;
   const bool use_Z = p == 2;
+  const IT sign = p == 1 ? 1 : -1;
   int next_eq_index = 0;
-  auto add_eq = [&next_eq_index, &lp, X, Y, Z, use_Z](IT X_coef, IT Y_coef, IT Z_coef, IT rhs) {
+  auto add_eq = [&next_eq_index, &lp, X, Y, Z, use_Z, sign](IT X_coef, IT Y_coef, IT Z_coef, IT rhs) {
     lp.set_a(X, next_eq_index, X_coef);
     lp.set_a(Y, next_eq_index, Y_coef);
     if (use_Z)
@@ -41,7 +632,7 @@ void testcase(int p)
     {
       assert(Z_coef == 0);
     }
-    lp.set_b(next_eq_index, rhs);
+    lp.set_b(next_eq_index, sign * rhs);
 
     next_eq_index++;
   };
@@ -59,24 +650,30 @@ void testcase(int p)
     add_eq(1, 1, 0, -4);
     add_eq(4, 2, 1, -(a * b));
     add_eq(-1, 1, 0, -1);
-    lp.set_c(X, a);
-    lp.set_c(Y, b);
-    lp.set_c(Z, 1);
+    lp.set_c(X, -a);
+    lp.set_c(Y, -b);
+    lp.set_c(Z, -1);
+  }
+  lp.set_nonnegative(X);
+  lp.set_nonnegative(Y);
+  if (use_Z)
+  {
+    lp.set_nonnegative(Z);
   }
 
-  Solution s = CGAL::solve_linear_program(lp, ET());
-  if (s.is_infeasible())
+  LinearProgramResult s = lp.solve(solver);
+  if (s.status == lp_infeasible)
   {
     std::cout << "no\n";
   }
-  else if (s.is_unbounded())
+  else if (s.status == lp_unbounded)
   {
     std::cout << "unbounded\n";
   }
   else
   {
-    assert(s.is_optimal());
-    int v = ceil(s.objective_value_numerator().to_double() / s.objective_value_denominator().to_double());
+    assert(s.status == lp_optimal);
+    int v = ceil(s.objective_numerator.to_double() / s.objective_denominator.to_double());
     if (p == 1)
     {
       v = -v;
@@ -89,6 +686,7 @@ int main()
 {
   std::ios_base::sync_with_stdio(false);
 
+  LinearProgramSolver solver = lp_solver_from_env();
   while (true)
   {
     int p;
@@ -97,7 +695,12 @@ int main()
     {
       break;
     }
-    testcase(p);
+    testcase(p, solver);
+  }
+
+  if (debug_level >= 1)
+  {
+    print_lp_stats();
   }
 
   return 0;
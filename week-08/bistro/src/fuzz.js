@@ -0,0 +1,96 @@
+const child_process = require("child_process");
+const path = require("path");
+
+const COMPILED_ALGORITHM_PATH = "../a"; // relative to this JS file
+
+function algorithmCpp(input) {
+  const inputLines = [`${input.oldLocations.length}`];
+  for (const p of input.oldLocations) {
+    inputLines.push(`${p[0]} ${p[1]}`);
+  }
+  inputLines.push(`${input.newLocations.length}`);
+  for (const p of input.newLocations) {
+    inputLines.push(`${p[0]} ${p[1]}`);
+  }
+  inputLines.push("0");
+
+  const output = child_process.execSync(
+    path.join(__dirname, COMPILED_ALGORITHM_PATH).replace(/ /g, "\\ "),
+    { input: inputLines.join("\n"), env: { ...process.env, NUM_THREADS: `${input.numThreads}` } }
+  );
+
+  return output.toString().trim().split("\n");
+}
+
+// nearestSquaredDistancesGolden compares every new location with every old one. The
+// squared distances are below 2^51, so they are exact as numbers.
+function nearestSquaredDistancesGolden(input) {
+  return input.newLocations.map((q) => {
+    let best = Infinity;
+    for (const p of input.oldLocations) {
+      best = Math.min(best, (p[0] - q[0]) ** 2 + (p[1] - q[1]) ** 2);
+    }
+    return `${best}`;
+  });
+}
+
+function randomInt(min, max) {
+  return min + Math.floor(Math.random() * (max - min + 1));
+}
+
+// genRandomInput returns random locations, or one of the degenerate cases where the
+// triangulation has duplicate points, is one point (dimension 0) or is one line
+// (dimension 1), with or without one more point off the line
+function genRandomInput(n, m) {
+  const r = [3, 10, 1000, (1 << 24) - 1][randomInt(0, 3)];
+  const randomLocation = () => [randomInt(-r, r), randomInt(-r, r)];
+  let oldLocations;
+  switch (randomInt(0, 4)) {
+    case 0:
+      oldLocations = Array.from({ length: n }, randomLocation);
+      break;
+    case 1: {
+      const distinct = Array.from({ length: Math.ceil(n / 3) }, randomLocation);
+      oldLocations = Array.from({ length: n }, () => distinct[randomInt(0, distinct.length - 1)]);
+      break;
+    }
+    case 2: {
+      const location = randomLocation();
+      oldLocations = Array.from({ length: n }, () => location);
+      break;
+    }
+    default: {
+      const a = randomInt(-5, 5), b = randomInt(-100, 100);
+      oldLocations = Array.from({ length: n }, () => {
+        const x = randomInt(-1000, 1000);
+        return [x, a * x + b];
+      });
+      if (Math.random() < 0.5) {
+        oldLocations.push([randomInt(-1000, 1000), a * randomInt(-1000, 1000) + b + randomInt(1, 1000)]);
+      }
+    }
+  }
+  const newLocations = Array.from({ length: m }, randomLocation);
+  return { oldLocations, newLocations, numThreads: randomInt(1, 4) };
+}
+
+function fuzz(maxBadInputs, minN, maxN) {
+  const badInputs = [];
+  for (let n = minN; n <= maxN; n *= 4) {
+    console.log(`n = ${n}`);
+    for (let j = 0; j < 200; j++) {
+      const input = genRandomInput(n, 4 * n);
+      const expected = nearestSquaredDistancesGolden(input);
+      const actual = algorithmCpp(input);
+      if (actual.join("\n") !== expected.join("\n")) {
+        badInputs.push({ input, expected, actual });
+        if (badInputs.length === maxBadInputs) {
+          return badInputs;
+        }
+      }
+    }
+  }
+  return badInputs;
+}
+
+console.log(fuzz(1, 1, 1024)[0]);
@@ -1,13 +1,255 @@
 #include <iostream>
 #include <cassert>
+#include <limits>
 #include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Delaunay_triangulation_2.h>
-#include <iomanip>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 typedef CGAL::Delaunay_triangulation_2<K> Triangulation;
 
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
+{
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
+
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
+
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
+
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
+
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
+  }
+
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
+  }
+
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
+{
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
+  {
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
+    {
+      write_char(*s++);
+    }
+  }
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
 const int debug_level = 0;
 
 #define DEBUG(min_level, x)      \
@@ -16,10 +258,136 @@ const int debug_level = 0;
     std::cerr << x << std::endl; \
   }
 
+const int hilbert_bits = 25;
+
+// hilbert_index returns the position of (x, y) along a Hilbert curve through the
+// 2^hilbert_bits x 2^hilbert_bits grid. Coordinates must be in [0, 2^hilbert_bits).
+uint64_t hilbert_index(uint32_t x, uint32_t y)
+{
+  const uint32_t n = uint32_t(1) << hilbert_bits;
+  uint64_t index = 0;
+  for (uint32_t s = n / 2; s > 0; s /= 2)
+  {
+    const uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+    index += uint64_t(s) * s * ((3 * rx) ^ ry);
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+
+// walk_to_nearest_vertex moves from start to closer and closer neighbors of the query.
+// In a Delaunay triangulation a vertex which isn't the nearest one always has a closer
+// neighbor, so the walk ends at the nearest vertex. Unlike nearest_vertex it only
+// reads the triangulation, so it can run on many threads at once.
+Triangulation::Vertex_handle walk_to_nearest_vertex(const Triangulation &triangulation, const K::Point_2 &query, Triangulation::Vertex_handle start)
+{
+  Triangulation::Vertex_handle current = start;
+  double current_distance = CGAL::squared_distance(query, current->point());
+  while (true)
+  {
+    Triangulation::Vertex_handle closest = current;
+    Triangulation::Vertex_circulator neighbor = triangulation.incident_vertices(current), done = neighbor;
+    do
+    {
+      if (!triangulation.is_infinite(neighbor))
+      {
+        double distance = CGAL::squared_distance(query, neighbor->point());
+        if (distance < current_distance)
+        {
+          closest = neighbor;
+          current_distance = distance;
+        }
+      }
+    } while (++neighbor != done);
+
+    if (closest == current)
+    {
+      return current;
+    }
+    current = closest;
+  }
+}
+
+// nearest_squared_distances returns, for every query in input order, the squared
+// distance to its nearest vertex. The queries are answered in Hilbert curve order, so
+// consecutive queries are close and each walk starts from the previous answer. Blocks
+// of the sorted queries are claimed from a shared counter by NUM_THREADS threads (one
+// per core if unset), which all read the same triangulation.
+std::vector<double> nearest_squared_distances(const Triangulation &triangulation, const std::vector<K::Point_2> &queries)
+{
+  const int m = queries.size();
+  std::vector<double> squared_distances(m);
+  if (triangulation.dimension() < 2)
+  {
+    // incident_vertices needs faces, so degenerate triangulations use nearest_vertex
+    for (int i = 0; i < m; i++)
+    {
+      squared_distances.at(i) = CGAL::squared_distance(queries.at(i), triangulation.nearest_vertex(queries.at(i))->point());
+    }
+    return squared_distances;
+  }
+
+  std::vector<std::pair<uint64_t, int>> keyed_queries(m);
+  for (int i = 0; i < m; i++)
+  {
+    const uint32_t offset = uint32_t(1) << (hilbert_bits - 1);
+    keyed_queries.at(i) = {hilbert_index(offset + int(queries.at(i).x()), offset + int(queries.at(i).y())), i};
+  }
+  std::sort(keyed_queries.begin(), keyed_queries.end());
+
+  const int block_size = 1024;
+  const int num_blocks = (m + block_size - 1) / block_size;
+  int num_threads = std::thread::hardware_concurrency();
+  if (const char *num_threads_env = std::getenv("NUM_THREADS"))
+  {
+    num_threads = std::atoi(num_threads_env);
+  }
+  num_threads = std::max(1, std::min(num_threads, num_blocks));
+
+  std::atomic<int> next_block(0);
+  const auto run_worker = [&]() {
+    Triangulation::Vertex_handle hint = triangulation.finite_vertices_begin();
+    while (true)
+    {
+      const int block = next_block++;
+      if (block >= num_blocks)
+      {
+        return;
+      }
+      for (int j = block * block_size; j < std::min(m, (block + 1) * block_size); j++)
+      {
+        const int i = keyed_queries[j].second;
+        hint = walk_to_nearest_vertex(triangulation, queries[i], hint);
+        squared_distances[i] = CGAL::squared_distance(queries[i], hint->point());
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_threads; i++)
+  {
+    threads.emplace_back(run_worker);
+  }
+  run_worker();
+  for (std::thread &thread : threads)
+  {
+    thread.join();
+  }
+
+  return squared_distances;
+}
+
 bool testcase()
 {
-  int n;
-  std::cin >> n;
+  int n = input.read_int();
   if (n == 0)
   {
     return false;
@@ -29,8 +397,7 @@ bool testcase()
   std::vector<K::Point_2> old_locations;
   for (int i = 0; i < n; i++)
   {
-    int x, y;
-    std::cin >> x >> y;
+    int x = input.read_int(), y = input.read_int();
     assert(abs(x) < (1 << 24) && abs(y) < (1 << 24));
     old_locations.emplace_back(x, y);
   }
@@ -38,20 +405,22 @@ bool testcase()
   Triangulation triangulation;
   triangulation.insert(old_locations.begin(), old_locations.end());
 
-  int m;
-  std::cin >> m;
+  int m = input.read_int();
   assert(m >= 1 && m <= 110000);
 
+  std::vector<K::Point_2> new_locations;
+  new_locations.reserve(m);
   for (int i = 0; i < m; i++)
   {
-    int x, y;
-    std::cin >> x >> y;
+    int x = input.read_int(), y = input.read_int();
     assert(abs(x) < (1 << 24) && abs(y) < (1 << 24));
-    K::Point_2 new_location(x, y);
-
-    auto old_location = triangulation.nearest_vertex(new_location)->point();
+    new_locations.emplace_back(x, y);
+  }
 
-    std::cout << std::fixed << std::setprecision(0) << CGAL::squared_distance(new_location, old_location) << "\n";
+  for (double squared_distance : nearest_squared_distances(triangulation, new_locations))
+  {
+    output.write_double(squared_distance, 0);
+    output.write_char('\n');
   }
 
   return true;
@@ -0,0 +1,206 @@
+const child_process = require("child_process");
+const path = require("path");
+
+const COMPILED_ALGORITHM_PATH = "../a"; // relative to this JS file
+
+function algorithmCpp(input) {
+  const inputLines = ["1", `${input.stations.length} ${input.clues.length} ${input.r}`];
+  for (const p of input.stations) {
+    inputLines.push(`${p[0]} ${p[1]}`);
+  }
+  for (const clue of input.clues) {
+    inputLines.push(`${clue[0][0]} ${clue[0][1]} ${clue[1][0]} ${clue[1][1]}`);
+  }
+
+  const output = child_process.execSync(
+    path.join(__dirname, COMPILED_ALGORITHM_PATH).replace(/ /g, "\\ "),
+    { input: inputLines.join("\n"), env: { ...process.env, NUM_THREADS: `${input.numThreads}` } }
+  );
+
+  return output.toString().trim();
+}
+
+function squaredDistance(p, q) {
+  return (p[0] - q[0]) ** 2 + (p[1] - q[1]) ** 2;
+}
+
+// cluesGolden 2-colors the graph of all station pairs at most r apart with a DFS, and
+// connects every radio set to its nearest station by comparing it with all of them
+function cluesGolden(input) {
+  const { stations, clues, r } = input;
+  const n = stations.length;
+  const isCloseEnough = (p, q) => squaredDistance(p, q) <= r * r;
+
+  const colors = new Array(n).fill(-1), components = new Array(n).fill(-1);
+  let isValid = true;
+  for (let start = 0; start < n; start++) {
+    if (colors[start] >= 0) {
+      continue;
+    }
+    colors[start] = 0;
+    components[start] = start;
+    const stack = [start];
+    while (stack.length > 0) {
+      const u = stack.pop();
+      for (let v = 0; v < n; v++) {
+        if (v === u || !isCloseEnough(stations[u], stations[v])) {
+          continue;
+        }
+        if (colors[v] < 0) {
+          colors[v] = 1 - colors[u];
+          components[v] = start;
+          stack.push(v);
+        } else if (colors[v] === colors[u]) {
+          isValid = false;
+        }
+      }
+    }
+  }
+
+  const componentOf = (radioSet) => {
+    let nearest = 0;
+    for (let i = 1; i < n; i++) {
+      if (squaredDistance(radioSet, stations[i]) < squaredDistance(radioSet, stations[nearest])) {
+        nearest = i;
+      }
+    }
+    return isCloseEnough(radioSet, stations[nearest]) ? components[nearest] : -1;
+  };
+
+  return clues
+    .map(([a, b]) => {
+      if (!isValid) {
+        return "n";
+      }
+      if (isCloseEnough(a, b)) {
+        return "y";
+      }
+      const component = componentOf(a);
+      return component >= 0 && component === componentOf(b) ? "y" : "n";
+    })
+    .join("");
+}
+
+function randomInt(min, max) {
+  return min + Math.floor(Math.random() * (max - min + 1));
+}
+
+// genStations returns sparse random stations, chains of stations just less than r
+// apart, collinear stations (a dimension 1 triangulation) or stations on a small grid
+// with many equal distances. Some stations are duplicated.
+function genStations(n, r) {
+  let stations;
+  switch (randomInt(0, 3)) {
+    case 0: {
+      const size = Math.ceil(r * Math.sqrt(n) * (1 + 3 * Math.random()));
+      stations = Array.from({ length: n }, () => [randomInt(-size, size), randomInt(-size, size)]);
+      break;
+    }
+    case 1: {
+      stations = [];
+      let x = 0, y = 0;
+      for (let i = 0; i < n; i++) {
+        stations.push([x, y]);
+        if (Math.random() < 0.3) {
+          x += 5 * r;
+          y += randomInt(-3 * r, 3 * r);
+        } else {
+          x += randomInt(Math.max(1, r - 3), r);
+        }
+      }
+      break;
+    }
+    case 2:
+      stations = Array.from({ length: n }, () => [randomInt(-30 * r, 30 * r), 7]);
+      break;
+    default:
+      stations = Array.from({ length: n }, () => [randomInt(0, 4) * r, randomInt(0, 4) * r]);
+  }
+  if (Math.random() < 0.2) {
+    stations.push(stations[randomInt(0, n - 1)]);
+  }
+  return stations;
+}
+
+// genRadioSet returns a radio set near a station or anywhere around the stations. Radio
+// sets with two nearest stations at different locations are skipped, since either one
+// may be chosen.
+function genRadioSet(stations, r) {
+  while (true) {
+    let radioSet;
+    if (Math.random() < 0.7) {
+      const station = stations[randomInt(0, stations.length - 1)];
+      radioSet = [station[0] + randomInt(-r, r), station[1] + randomInt(-r, r)];
+    } else {
+      const xs = stations.map((p) => p[0]), ys = stations.map((p) => p[1]);
+      radioSet = [
+        randomInt(Math.min(...xs) - 2 * r, Math.max(...xs) + 2 * r),
+        randomInt(Math.min(...ys) - 2 * r, Math.max(...ys) + 2 * r),
+      ];
+    }
+    const nearest = Math.min(...stations.map((p) => squaredDistance(p, radioSet)));
+    const nearestStations = stations.filter((p) => squaredDistance(p, radioSet) === nearest);
+    if (nearestStations.every((p) => p[0] === nearestStations[0][0] && p[1] === nearestStations[0][1])) {
+      return radioSet;
+    }
+  }
+}
+
+function genRandomInput(n, m) {
+  const r = randomInt(1, 50);
+  const stations = genStations(n, r);
+  const clues = Array.from({ length: m }, () => [genRadioSet(stations, r), genRadioSet(stations, r)]);
+  return { stations, clues, r, numThreads: randomInt(1, 4) };
+}
+
+// FIXED_INPUTS have two stations of the same color which are close enough but not a
+// Delaunay edge of all stations: (1, 4) and (6, 10) with r = 9 (invalid), and the same
+// stations with r = 7, where they are too far apart (valid)
+const FIXED_INPUTS = [9, 7].map((r) => ({
+  stations: [
+    [1, 4],
+    [2, 7],
+    [12, 1],
+    [6, 10],
+  ],
+  clues: [
+    [
+      [1, 5],
+      [6, 9],
+    ],
+    [
+      [1, 4],
+      [2, 7],
+    ],
+  ],
+  r,
+  numThreads: 1,
+}));
+
+function fuzz(maxBadInputs, minN, maxN) {
+  const badInputs = [];
+  const check = (input) => {
+    const expected = cluesGolden(input);
+    const actual = algorithmCpp(input);
+    if (actual !== expected) {
+      badInputs.push({ input, expected, actual });
+    }
+    return badInputs.length === maxBadInputs;
+  };
+  for (const input of FIXED_INPUTS) {
+    if (check(input)) {
+      return badInputs;
+    }
+  }
+  for (let n = minN; n <= maxN; n *= 4) {
+    console.log(`n = ${n}`);
+    for (let j = 0; j < 200; j++) {
+      if (check(genRandomInput(n, n))) {
+        return badInputs;
+      }
+    }
+  }
+  return badInputs;
+}
+
+console.log(fuzz(1, 2, 512)[0]);
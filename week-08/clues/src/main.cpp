@@ -1,13 +1,25 @@
 #include <iostream>
 #include <cassert>
+#include <limits>
 #include <vector>
-#include <deque>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <tuple>
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Delaunay_triangulation_2.h>
 #include <CGAL/Triangulation_data_structure_2.h>
 #include <CGAL/Triangulation_vertex_base_with_info_2.h>
 #include <CGAL/Triangulation_face_base_2.h>
 #include <boost/graph/adjacency_list.hpp>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 const int debug_level = 0;
 
@@ -24,34 +36,353 @@ typedef CGAL::Triangulation_data_structure_2<TVB, TFB> TriangulationDataStructur
 typedef CGAL::Delaunay_triangulation_2<K, TriangulationDataStructure> Triangulation;
 typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
 
+// InputReader parses whitespace separated tokens straight from the bytes of stdin,
+// without the locale and stream state handling of std::cin. Regular files are
+// memory-mapped, pipes are read into one large buffer up front.
+class InputReader
+{
+public:
+  InputReader()
+  {
+    struct stat input_stat;
+    if (fstat(STDIN_FILENO, &input_stat) == 0 && S_ISREG(input_stat.st_mode) && input_stat.st_size > 0 && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0)
+    {
+      void *mapped = mmap(nullptr, input_stat.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+      if (mapped != MAP_FAILED)
+      {
+        pos = static_cast<const char *>(mapped);
+        end = pos + input_stat.st_size;
+        return;
+      }
+    }
+
+    size_t size = 0;
+    buffer.resize(1 << 20);
+    while (true)
+    {
+      if (size == buffer.size())
+      {
+        buffer.resize(2 * buffer.size());
+      }
+      ssize_t read_size = read(STDIN_FILENO, buffer.data() + size, buffer.size() - size);
+      if (read_size <= 0)
+      {
+        break;
+      }
+      size += read_size;
+    }
+    pos = buffer.data();
+    end = pos + size;
+  }
+
+  long read_long()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    assert(pos < end && *pos >= '0' && *pos <= '9');
+    long value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      value = value * 10 + (*pos - '0');
+      pos++;
+    }
+    return negative ? -value : value;
+  }
+
+  int read_int()
+  {
+    long value = read_long();
+    assert(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max());
+    return value;
+  }
+
+  // read_double is exact for inputs with at most 15 significant digits,
+  // which covers every input format of this course.
+  double read_double()
+  {
+    skip_whitespace();
+    bool negative = pos < end && *pos == '-';
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+      pos++;
+    }
+    long mantissa = 0;
+    int exponent = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      pos++;
+    }
+    if (pos < end && *pos == '.')
+    {
+      pos++;
+      while (pos < end && *pos >= '0' && *pos <= '9')
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        exponent--;
+        pos++;
+      }
+    }
+    double value = mantissa;
+    if (exponent < 0)
+    {
+      value /= std::pow(10.0, -exponent);
+    }
+    return negative ? -value : value;
+  }
+
+  std::string read_string()
+  {
+    skip_whitespace();
+    const char *start = pos;
+    while (pos < end && *pos > ' ')
+    {
+      pos++;
+    }
+    return std::string(start, pos);
+  }
+
+  void skip_line()
+  {
+    while (pos < end && *pos != '\n')
+    {
+      pos++;
+    }
+    if (pos < end)
+    {
+      pos++;
+    }
+  }
+
+private:
+  void skip_whitespace()
+  {
+    while (pos < end && *pos <= ' ')
+    {
+      pos++;
+    }
+  }
+
+  std::vector<char> buffer;
+  const char *pos, *end;
+};
+
+InputReader input;
+
+// OutputWriter formats output straight into a large buffer, which is written to
+// stdout in one go when it is full and when the writer is destroyed.
+class OutputWriter
+{
+public:
+  OutputWriter() : buffer(1 << 20), size(0) {}
+
+  ~OutputWriter()
+  {
+    flush();
+  }
+
+  void write_char(char c)
+  {
+    reserve(1);
+    buffer[size++] = c;
+  }
+
+  void write_string(const char *s)
+  {
+    while (*s)
+    {
+      write_char(*s++);
+    }
+  }
+
+  void write_long(long value)
+  {
+    reserve(20);
+    unsigned long magnitude = value;
+    if (value < 0)
+    {
+      buffer[size++] = '-';
+      magnitude = -magnitude;
+    }
+    char digits[20];
+    int num_digits = 0;
+    do
+    {
+      digits[num_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    while (num_digits > 0)
+    {
+      buffer[size++] = digits[--num_digits];
+    }
+  }
+
+  void write_int(int value)
+  {
+    write_long(value);
+  }
+
+  // write_double prints like std::fixed << std::setprecision(precision)
+  void write_double(double value, int precision)
+  {
+    if (precision == 0 && value == std::floor(value) && std::abs(value) < 1e18)
+    {
+      write_long(value);
+      return;
+    }
+    reserve(64);
+    int written = snprintf(buffer.data() + size, 64, "%.*f", precision, value);
+    assert(written > 0 && written < 64);
+    size += written;
+  }
+
+  void flush()
+  {
+    size_t flushed = 0;
+    while (flushed < size)
+    {
+      ssize_t written = write(STDOUT_FILENO, buffer.data() + flushed, size - flushed);
+      assert(written > 0);
+      flushed += written;
+    }
+    size = 0;
+  }
+
+private:
+  void reserve(size_t needed)
+  {
+    if (size + needed > buffer.size())
+    {
+      flush();
+    }
+  }
+
+  std::vector<char> buffer;
+  size_t size;
+};
+
+OutputWriter output;
+
 K::Point_2 read_point()
 {
-  int x, y;
-  std::cin >> x >> y;
+  int x = input.read_int(), y = input.read_int();
   assert(abs(x) < (1 << 24) && abs(y) < (1 << 24));
   return K::Point_2(x, y);
 }
 
-inline Triangulation::Vertex_handle vertex_from_edge(Triangulation::Edge &edge, int i)
+inline Triangulation::Vertex_handle vertex_from_edge(const Triangulation::Edge &edge, int i)
 {
   assert(i == 0 || i == 1);
   return edge.first->vertex((edge.second + 1 + i) % 3);
 }
 
-inline Triangulation::Vertex_handle other_vertex_from_edge(Triangulation::Edge &edge, Triangulation::Vertex_handle &v)
+// ParityUnionFind is a union-find which also stores for every station whether it has a
+// different color than its parent, so after find the parity of a station is its color
+// relative to the root of its set.
+class ParityUnionFind
+{
+public:
+  explicit ParityUnionFind(int n) : parents(n), parities(n, 0), ranks(n, 0)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      parents[i] = i;
+    }
+  }
+
+  int find(int v)
+  {
+    const int parent = parents[v];
+    if (parent == v)
+    {
+      return v;
+    }
+    const int root = find(parent);
+    parities[v] ^= parities[parent];
+    parents[v] = root;
+    return root;
+  }
+
+  int color(int v)
+  {
+    find(v);
+    return parities[v];
+  }
+
+  // join records that a and b have different colors. It returns false if they are
+  // already known to have the same color, which means there is an odd cycle.
+  bool join(int a, int b)
+  {
+    const int root_a = find(a), root_b = find(b);
+    if (root_a == root_b)
+    {
+      return parities[a] != parities[b];
+    }
+    const int parity = parities[a] ^ parities[b] ^ 1;
+    if (ranks[root_a] < ranks[root_b])
+    {
+      parents[root_a] = root_b;
+      parities[root_a] = parity;
+    }
+    else
+    {
+      parents[root_b] = root_a;
+      parities[root_b] = parity;
+      if (ranks[root_a] == ranks[root_b])
+      {
+        ranks[root_a]++;
+      }
+    }
+    return true;
+  }
+
+private:
+  std::vector<int> parents, parities, ranks;
+};
+
+// has_close_same_color_pair returns whether two stations of the same color are at most
+// r apart. Such pairs aren't always edges of the triangulation of all stations, so this
+// can't be decided from the Delaunay edges alone. Instead every station is compared with
+// the stations of its color in the same and the adjacent cells of a grid with side r.
+// A cell can only hold a few stations of one color which are pairwise further apart
+// than r, so this takes a linear number of comparisons until the first conflict.
+template <typename IsCloseEnough>
+bool has_close_same_color_pair(const std::vector<K::Point_2> &stations, const std::vector<int> &color_by_station, int r, IsCloseEnough is_close_enough)
 {
-  auto vertex_a = vertex_from_edge(edge, 0);
-  auto vertex_b = vertex_from_edge(edge, 1);
-  if (vertex_a == v)
+  const int n = stations.size();
+  // coordinates and r are integers below 2^24, so floor of the double quotient is exact
+  const auto cell_of = [r](double coordinate) { return long(std::floor(coordinate / r)); };
+  std::vector<std::tuple<int, long, long, int>> stations_by_cell(n);
+  for (int i = 0; i < n; i++)
   {
-    return vertex_b;
+    stations_by_cell[i] = std::make_tuple(color_by_station[i], cell_of(stations[i].x()), cell_of(stations[i].y()), i);
   }
-  else if (vertex_b == v)
+  std::sort(stations_by_cell.begin(), stations_by_cell.end());
+
+  for (const auto &station : stations_by_cell)
   {
-    return vertex_a;
+    const int color = std::get<0>(station), i = std::get<3>(station);
+    for (long cell_x = std::get<1>(station) - 1; cell_x <= std::get<1>(station) + 1; cell_x++)
+    {
+      for (long cell_y = std::get<2>(station) - 1; cell_y <= std::get<2>(station) + 1; cell_y++)
+      {
+        auto it = std::lower_bound(stations_by_cell.begin(), stations_by_cell.end(), std::make_tuple(color, cell_x, cell_y, 0));
+        for (; it != stations_by_cell.end() && std::get<0>(*it) == color && std::get<1>(*it) == cell_x && std::get<2>(*it) == cell_y; it++)
+        {
+          const int j = std::get<3>(*it);
+          if (j != i && is_close_enough(CGAL::squared_distance(stations[i], stations[j])))
+          {
+            return true;
+          }
+        }
+      }
+    }
   }
-  assert(false);
-  __builtin_unreachable();
+  return false;
 }
 
 struct NetworkAnalysis
@@ -62,163 +393,242 @@ struct NetworkAnalysis
   std::vector<int> component_map;
 };
 
-NetworkAnalysis analyze_network(std::vector<std::pair<K::Point_2, int>> radio_stations, Triangulation &all_stations_triangulation, std::function<bool(double)> is_close_enough)
+// analyze_network extracts the Delaunay edges which are short enough once, and joins
+// their stations in a ParityUnionFind. This gives the connected components and a
+// 2-coloring (or an odd cycle) in near linear time.
+template <typename IsCloseEnough>
+NetworkAnalysis analyze_network(const std::vector<K::Point_2> &stations, const Triangulation &all_stations_triangulation, int r, IsCloseEnough is_close_enough)
 {
-  const int n = radio_stations.size();
+  const int n = stations.size();
   NetworkAnalysis network_analysis(n);
 
-  std::vector<Triangulation::Vertex_handle> all_stations_triangulation_handles(n);
-  for (auto it = all_stations_triangulation.finite_vertices_begin(); it != all_stations_triangulation.finite_vertices_end(); it++)
+  std::vector<std::pair<int, int>> close_edges;
+  for (auto it = all_stations_triangulation.finite_edges_begin(); it != all_stations_triangulation.finite_edges_end(); it++)
   {
-    all_stations_triangulation_handles.at(it->info()) = it;
+    auto vertex_a = vertex_from_edge(*it, 0), vertex_b = vertex_from_edge(*it, 1);
+    if (is_close_enough(CGAL::squared_distance(vertex_a->point(), vertex_b->point())))
+    {
+      close_edges.emplace_back(vertex_a->info(), vertex_b->info());
+    }
   }
+  DEBUG(2, "close_edges.size() " << close_edges.size());
 
-  std::deque<std::pair<int, int>> queue;
-  std::vector<int> color_by_station(n, -1);
-  int next_connected_component = 0;
-  for (int queue_starter = 0; queue_starter < n; queue_starter++)
+  ParityUnionFind union_find(n);
+  bool is_bipartite = true;
+  for (const auto &edge : close_edges)
   {
-    if (network_analysis.component_map.at(queue_starter) >= 0)
+    is_bipartite &= union_find.join(edge.first, edge.second);
+  }
+
+  // stations at the same location share one vertex, so the others are joined to the
+  // station which has it (at distance 0 they always interfere)
+  std::vector<bool> has_vertex(n, false);
+  for (auto it = all_stations_triangulation.finite_vertices_begin(); it != all_stations_triangulation.finite_vertices_end(); it++)
+  {
+    has_vertex.at(it->info()) = true;
+  }
+  for (int i = 0; i < n; i++)
+  {
+    if (!has_vertex.at(i))
     {
-      continue;
+      is_bipartite &= union_find.join(i, all_stations_triangulation.nearest_vertex(stations.at(i))->info());
     }
-    queue.push_back(std::make_pair(queue_starter, 0));
-    const int this_connected_component = next_connected_component++;
-    network_analysis.component_map.at(queue_starter) = this_connected_component;
+  }
 
-    while (!queue.empty())
-    {
-      int prev_index = queue.front().first;
-      int prev_color = queue.front().second;
-      queue.pop_front();
-      K::Point_2 &prev_point = radio_stations.at(prev_index).first;
+  std::vector<int> color_by_station(n);
+  for (int i = 0; i < n; i++)
+  {
+    network_analysis.component_map.at(i) = union_find.find(i);
+    color_by_station.at(i) = union_find.color(i);
+  }
 
-      assert(color_by_station.at(prev_index) == -1);
-      color_by_station.at(prev_index) = prev_color;
+  network_analysis.valid = is_bipartite && !has_close_same_color_pair(stations, color_by_station, r, is_close_enough);
+  return network_analysis;
+}
 
-      auto &prev_vertex = all_stations_triangulation_handles.at(prev_index);
-      Triangulation::Edge_circulator c = all_stations_triangulation.incident_edges(prev_vertex);
-      do
-      {
-        if (all_stations_triangulation.is_infinite(c))
-        {
-          continue;
-        }
+const int hilbert_bits = 25;
 
-        auto next_vertex = other_vertex_from_edge(*c, prev_vertex);
-        int next_index = next_vertex->info();
-        K::Point_2 &next_point = next_vertex->point();
-        int next_color = 1 - prev_color;
+// hilbert_index returns the position of (x, y) along a Hilbert curve through the
+// 2^hilbert_bits x 2^hilbert_bits grid. Coordinates must be in [0, 2^hilbert_bits).
+uint64_t hilbert_index(uint32_t x, uint32_t y)
+{
+  const uint32_t n = uint32_t(1) << hilbert_bits;
+  uint64_t index = 0;
+  for (uint32_t s = n / 2; s > 0; s /= 2)
+  {
+    const uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+    index += uint64_t(s) * s * ((3 * rx) ^ ry);
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
 
-        if (network_analysis.component_map.at(next_index) == -1 && is_close_enough(CGAL::squared_distance(prev_point, next_point)))
+// walk_to_nearest_vertex moves from start to closer and closer neighbors of the query.
+// In a Delaunay triangulation a vertex which isn't the nearest one always has a closer
+// neighbor, so the walk ends at the nearest vertex. Unlike nearest_vertex it only
+// reads the triangulation, so it can run on many threads at once.
+Triangulation::Vertex_handle walk_to_nearest_vertex(const Triangulation &triangulation, const K::Point_2 &query, Triangulation::Vertex_handle start)
+{
+  Triangulation::Vertex_handle current = start;
+  double current_distance = CGAL::squared_distance(query, current->point());
+  while (true)
+  {
+    Triangulation::Vertex_handle closest = current;
+    Triangulation::Vertex_circulator neighbor = triangulation.incident_vertices(current), done = neighbor;
+    do
+    {
+      if (!triangulation.is_infinite(neighbor))
+      {
+        double distance = CGAL::squared_distance(query, neighbor->point());
+        if (distance < current_distance)
         {
-          network_analysis.component_map.at(next_index) = this_connected_component;
-          queue.push_front(std::make_pair(next_index, next_color));
+          closest = neighbor;
+          current_distance = distance;
         }
-      } while (++c != all_stations_triangulation.incident_edges(prev_vertex));
+      }
+    } while (++neighbor != done);
+
+    if (closest == current)
+    {
+      return current;
     }
+    current = closest;
   }
+}
 
-  assert(*std::min_element(network_analysis.component_map.begin(), network_analysis.component_map.end()) >= 0);
+// for_each_nearest_vertex calls on_nearest(i, vertex) with the nearest vertex of every
+// query. The queries are handled in Hilbert curve order, so each walk starts from the
+// previous answer, and blocks of them are claimed from a shared counter by NUM_THREADS
+// threads (one per core if unset), which all read the same triangulation.
+template <typename OnNearest>
+void for_each_nearest_vertex(const Triangulation &triangulation, const std::vector<K::Point_2> &queries, OnNearest on_nearest)
+{
+  const int m = queries.size();
+  if (triangulation.dimension() < 2)
+  {
+    // incident_vertices needs faces, so degenerate triangulations use nearest_vertex
+    for (int i = 0; i < m; i++)
+    {
+      on_nearest(i, triangulation.nearest_vertex(queries.at(i)));
+    }
+    return;
+  }
 
-  std::vector<std::vector<K::Point_2>> point_vectors_by_color(2);
-  for (int i = 0; i < n; i++)
+  std::vector<std::pair<uint64_t, int>> keyed_queries(m);
+  for (int i = 0; i < m; i++)
   {
-    int color = color_by_station.at(i);
-    point_vectors_by_color.at(color).push_back(radio_stations.at(i).first);
+    const uint32_t offset = uint32_t(1) << (hilbert_bits - 1);
+    keyed_queries.at(i) = {hilbert_index(offset + int(queries.at(i).x()), offset + int(queries.at(i).y())), i};
   }
+  std::sort(keyed_queries.begin(), keyed_queries.end());
 
-  for (auto &points_this_color : point_vectors_by_color)
+  const int block_size = 1024;
+  const int num_blocks = (m + block_size - 1) / block_size;
+  int num_threads = std::thread::hardware_concurrency();
+  if (const char *num_threads_env = std::getenv("NUM_THREADS"))
   {
-    Triangulation color_triangulation;
-    color_triangulation.insert(points_this_color.begin(), points_this_color.end());
-    for (auto it = color_triangulation.finite_edges_begin(); it != color_triangulation.finite_edges_end(); it++)
+    num_threads = std::atoi(num_threads_env);
+  }
+  num_threads = std::max(1, std::min(num_threads, num_blocks));
+
+  std::atomic<int> next_block(0);
+  const auto run_worker = [&]() {
+    Triangulation::Vertex_handle hint = triangulation.finite_vertices_begin();
+    while (true)
     {
-      if (is_close_enough(color_triangulation.segment(it).squared_length()))
+      const int block = next_block++;
+      if (block >= num_blocks)
       {
-        return network_analysis;
+        return;
+      }
+      for (int j = block * block_size; j < std::min(m, (block + 1) * block_size); j++)
+      {
+        const int i = keyed_queries[j].second;
+        hint = walk_to_nearest_vertex(triangulation, queries[i], hint);
+        on_nearest(i, hint);
       }
     }
-  }
+  };
 
-  network_analysis.valid = true;
-  return network_analysis;
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_threads; i++)
+  {
+    threads.emplace_back(run_worker);
+  }
+  run_worker();
+  for (std::thread &thread : threads)
+  {
+    thread.join();
+  }
 }
 
 void testcase()
 {
-  int n, m, r;
-  std::cin >> n >> m >> r;
+  int n = input.read_int(), m = input.read_int(), r = input.read_int();
   assert(n >= 1 && n <= 9e4 && m >= 1 && m <= 9e4 && r > 0 && r < (1 << 24));
 
   const double r_squared = pow(double(r), 2);
   const auto is_close_enough = [r_squared](double sqlen) { return sqlen <= r_squared; };
 
+  std::vector<K::Point_2> stations;
   std::vector<std::pair<K::Point_2, int>> radio_stations;
   for (int i = 0; i < n; i++)
   {
-    radio_stations.push_back(std::make_pair(read_point(), i));
+    stations.push_back(read_point());
+    radio_stations.push_back(std::make_pair(stations.back(), i));
   }
 
-  std::vector<std::pair<K::Point_2, K::Point_2>> clues;
-  for (int i = 0; i < m; i++)
+  // clue i is the pair of radio sets 2 * i and 2 * i + 1
+  std::vector<K::Point_2> radio_sets;
+  for (int i = 0; i < 2 * m; i++)
   {
-    auto p1 = read_point();
-    auto p2 = read_point();
-    clues.push_back(std::make_pair(p1, p2));
+    radio_sets.push_back(read_point());
   }
 
   Triangulation all_stations_triangulation;
   all_stations_triangulation.insert(radio_stations.begin(), radio_stations.end());
 
-  NetworkAnalysis network_analysis = analyze_network(radio_stations, all_stations_triangulation, is_close_enough);
+  NetworkAnalysis network_analysis = analyze_network(stations, all_stations_triangulation, r, is_close_enough);
   DEBUG(2, "network_analysis.valid " << network_analysis.valid);
 
-  const auto network_component_from_radio_set = [&is_close_enough, &all_stations_triangulation, &network_analysis](K::Point_2 &radio_set) -> int {
-    auto nearest_station = all_stations_triangulation.nearest_vertex(radio_set);
-    double set_station_sq_dist = CGAL::squared_distance(radio_set, nearest_station->point());
-    if (!is_close_enough(set_station_sq_dist))
-    {
-      return -1;
-    }
-    return network_analysis.component_map.at(nearest_station->info());
-  };
-
   std::vector<bool> can_transmit_by_clue(m, false);
   if (network_analysis.valid)
   {
+    // the network component each radio set can reach, or -1 if no station is close enough
+    std::vector<int> component_by_radio_set(2 * m);
+    for_each_nearest_vertex(all_stations_triangulation, radio_sets, [&](int i, Triangulation::Vertex_handle nearest_station) {
+      const bool is_reachable = is_close_enough(CGAL::squared_distance(radio_sets[i], nearest_station->point()));
+      component_by_radio_set[i] = is_reachable ? network_analysis.component_map[nearest_station->info()] : -1;
+    });
+
     for (int i = 0; i < m; i++)
     {
       DEBUG(3, "clue " << i);
-      auto &clue = clues.at(i);
-      if (is_close_enough(CGAL::squared_distance(clue.first, clue.second)))
-      {
-        can_transmit_by_clue.at(i) = true;
-      }
-      else
-      {
-        int first_component = network_component_from_radio_set(clue.first);
-        if (first_component >= 0 && first_component == network_component_from_radio_set(clue.second))
-        {
-          can_transmit_by_clue.at(i) = true;
-        }
-      }
+      const int first_component = component_by_radio_set.at(2 * i), second_component = component_by_radio_set.at(2 * i + 1);
+      can_transmit_by_clue.at(i) = is_close_enough(CGAL::squared_distance(radio_sets.at(2 * i), radio_sets.at(2 * i + 1))) || (first_component >= 0 && first_component == second_component);
     }
   }
 
   for (bool can_transmit : can_transmit_by_clue)
   {
-    std::cout << (can_transmit ? "y" : "n");
+    output.write_char(can_transmit ? 'y' : 'n');
   }
-  std::cout << "\n";
+  output.write_char('\n');
 }
 
 int main()
 {
   std::ios_base::sync_with_stdio(false);
 
-  int t;
-  std::cin >> t;
+  int t = input.read_int();
   for (int i = 0; i < t; i++)
   {
     testcase();
@@ -1,15 +1,8 @@
 #include <iostream>
 #include <cassert>
 #include <vector>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/push_relabel_max_flow.hpp>
-
-typedef boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS> GraphTraits;
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::no_property,
-                              boost::property<boost::edge_capacity_t, long,
-                                              boost::property<boost::edge_residual_capacity_t, long,
-                                                              boost::property<boost::edge_reverse_t, GraphTraits::edge_descriptor>>>>
-    Graph;
+#include <limits>
+#include <algorithm>
 
 const int debug_level = 0;
 
@@ -30,23 +23,193 @@ const std::vector<std::pair<int, int>> attack_offsets{
     {2, 1},
 };
 
-class EdgeAdder
+// FlowNetwork is a directed flow network with a built-in max flow solver (Dinic's
+// algorithm). Edges are collected with add_edge into arrays reserved up front, and laid
+// out once in compressed sparse row form when the first flow is computed: the arcs
+// leaving node a are [arc_offsets[a], arc_offsets[a + 1]), and every arc stores the
+// index of its paired reverse arc. This avoids the allocation per arc and reverse arc
+// of a boost::adjacency_list.
+class FlowNetwork
 {
-  Graph &G;
-
 public:
-  explicit EdgeAdder(Graph &G) : G(G) {}
-  void add_edge(int from, int to, long capacity)
+  explicit FlowNetwork(int num_nodes, int expected_edges = 0) : num_nodes(num_nodes), is_built(false)
+  {
+    edge_froms.reserve(expected_edges);
+    edge_tos.reserve(expected_edges);
+    edge_capacities.reserve(expected_edges);
+  }
+
+  // add_edge adds an edge with the given capacity and returns its index
+  int add_edge(int from, int to, long capacity)
+  {
+    assert(!is_built);
+    assert(from >= 0 && from < num_nodes && to >= 0 && to < num_nodes && capacity >= 0);
+    edge_froms.push_back(from);
+    edge_tos.push_back(to);
+    edge_capacities.push_back(capacity);
+    return edge_froms.size() - 1;
+  }
+
+  // max_flow returns the value of a maximum flow from source to sink. Every call starts
+  // from an empty flow, so one network can be solved for several sources and sinks.
+  long max_flow(int source, int sink)
+  {
+    assert(source >= 0 && source < num_nodes && sink >= 0 && sink < num_nodes && source != sink);
+    build();
+    arc_residuals = arc_capacities;
+    long flow = 0;
+    while (compute_levels(source, sink))
+    {
+      next_arcs.assign(arc_offsets.begin(), arc_offsets.end() - 1);
+      while (long pushed = push_flow(source, sink, std::numeric_limits<long>::max()))
+      {
+        flow += pushed;
+      }
+    }
+    return flow;
+  }
+
+  // flow_on_edge returns how much of the last computed flow goes through edge
+  long flow_on_edge(int edge) const
+  {
+    int arc = edge_arcs.at(edge);
+    return arc_capacities.at(arc) - arc_residuals.at(arc);
+  }
+
+  // reachable_from returns which nodes can be reached from source along arcs with
+  // residual capacity. After max_flow(source, sink) this is the source side of a
+  // minimum cut.
+  std::vector<bool> reachable_from(int source) const
+  {
+    std::vector<bool> is_reachable(num_nodes, false);
+    std::vector<int> queue{source};
+    is_reachable.at(source) = true;
+    for (int i = 0; i < int(queue.size()); i++)
+    {
+      int node = queue[i];
+      for (int arc = arc_offsets[node]; arc < arc_offsets[node + 1]; arc++)
+      {
+        int next_node = arc_targets[arc];
+        if (arc_residuals[arc] > 0 && !is_reachable[next_node])
+        {
+          is_reachable[next_node] = true;
+          queue.push_back(next_node);
+        }
+      }
+    }
+    return is_reachable;
+  }
+
+  // cut_capacity returns the total capacity of the edges which go from a node with
+  // is_inside set to a node without
+  long cut_capacity(const std::vector<bool> &is_inside) const
+  {
+    long capacity = 0;
+    for (int i = 0; i < int(edge_froms.size()); i++)
+    {
+      if (is_inside.at(edge_froms[i]) && !is_inside.at(edge_tos[i]))
+      {
+        capacity += edge_capacities[i];
+      }
+    }
+    return capacity;
+  }
+
+private:
+  void build()
+  {
+    if (is_built)
+    {
+      return;
+    }
+    is_built = true;
+
+    int num_edges = edge_froms.size();
+    arc_offsets.assign(num_nodes + 1, 0);
+    for (int i = 0; i < num_edges; i++)
+    {
+      arc_offsets[edge_froms[i] + 1]++;
+      arc_offsets[edge_tos[i] + 1]++;
+    }
+    for (int node = 0; node < num_nodes; node++)
+    {
+      arc_offsets[node + 1] += arc_offsets[node];
+    }
+
+    arc_targets.resize(2 * num_edges);
+    arc_reverses.resize(2 * num_edges);
+    arc_capacities.resize(2 * num_edges);
+    edge_arcs.resize(num_edges);
+    std::vector<int> next_slots(arc_offsets.begin(), arc_offsets.end() - 1);
+    for (int i = 0; i < num_edges; i++)
+    {
+      int arc = next_slots[edge_froms[i]]++, reverse_arc = next_slots[edge_tos[i]]++;
+      arc_targets[arc] = edge_tos[i];
+      arc_targets[reverse_arc] = edge_froms[i];
+      arc_reverses[arc] = reverse_arc;
+      arc_reverses[reverse_arc] = arc;
+      arc_capacities[arc] = edge_capacities[i];
+      arc_capacities[reverse_arc] = 0;
+      edge_arcs[i] = arc;
+    }
+  }
+
+  // compute_levels sets levels to the BFS distance from source in the residual network
+  // and returns whether sink is reachable
+  bool compute_levels(int source, int sink)
+  {
+    levels.assign(num_nodes, -1);
+    queue.clear();
+    queue.push_back(source);
+    levels[source] = 0;
+    for (int i = 0; i < int(queue.size()) && levels[sink] == -1; i++)
+    {
+      int node = queue[i];
+      for (int arc = arc_offsets[node]; arc < arc_offsets[node + 1]; arc++)
+      {
+        int next_node = arc_targets[arc];
+        if (arc_residuals[arc] > 0 && levels[next_node] == -1)
+        {
+          levels[next_node] = levels[node] + 1;
+          queue.push_back(next_node);
+        }
+      }
+    }
+    return levels[sink] != -1;
+  }
+
+  // push_flow sends at most limit units along one path of increasing levels from node
+  // to sink and returns how much it sent. Arcs which can not lead to the sink anymore
+  // are skipped for the rest of the phase via next_arcs.
+  long push_flow(int node, int sink, long limit)
   {
-    auto c_map = boost::get(boost::edge_capacity, G);
-    auto r_map = boost::get(boost::edge_reverse, G);
-    const Graph::edge_descriptor e = boost::add_edge(from, to, G).first;
-    const Graph::edge_descriptor rev_e = boost::add_edge(to, from, G).first;
-    c_map[e] = capacity;
-    c_map[rev_e] = 0; // reverse edge has no capacity!
-    r_map[e] = rev_e;
-    r_map[rev_e] = e;
+    if (node == sink)
+    {
+      return limit;
+    }
+    for (int &arc = next_arcs[node]; arc < arc_offsets[node + 1]; arc++)
+    {
+      int next_node = arc_targets[arc];
+      if (arc_residuals[arc] > 0 && levels[next_node] == levels[node] + 1)
+      {
+        long pushed = push_flow(next_node, sink, std::min(limit, arc_residuals[arc]));
+        if (pushed > 0)
+        {
+          arc_residuals[arc] -= pushed;
+          arc_residuals[arc_reverses[arc]] += pushed;
+          return pushed;
+        }
+      }
+    }
+    return 0;
   }
+
+  int num_nodes;
+  bool is_built;
+  std::vector<int> edge_froms, edge_tos, edge_arcs;
+  std::vector<long> edge_capacities;
+  std::vector<int> arc_offsets, arc_targets, arc_reverses, levels, queue, next_arcs;
+  std::vector<long> arc_capacities, arc_residuals;
 };
 
 void testcase()
@@ -80,9 +243,7 @@ void testcase()
   next_free_node += n * n;
   const int num_nodes = next_free_node;
 
-  Graph G(num_nodes);
-  EdgeAdder adder(G);
-  auto rc_map = boost::get(boost::edge_residual_capacity, G);
+  FlowNetwork network(num_nodes, 5 * n * n);
 
   for (int i = 0; i < n; i++)
   {
@@ -95,11 +256,11 @@ void testcase()
 
       if (square_is_white(i, j))
       {
-        adder.add_edge(node_source, get_node_for_square(i, j), 1);
+        network.add_edge(node_source, get_node_for_square(i, j), 1);
       }
       else
       {
-        adder.add_edge(get_node_for_square(i, j), node_sink, 1);
+        network.add_edge(get_node_for_square(i, j), node_sink, 1);
         continue;
       }
 
@@ -112,30 +273,13 @@ void testcase()
           continue;
         }
         assert(!square_is_white(attack_i, attack_j));
-        adder.add_edge(get_node_for_square(i, j), get_node_for_square(attack_i, attack_j), 1);
+        network.add_edge(get_node_for_square(i, j), get_node_for_square(attack_i, attack_j), 1);
       }
     }
   }
 
-  boost::push_relabel_max_flow(G, node_source, node_sink);
-
-  std::vector<bool> visited_by_node(num_nodes, false);
-  visited_by_node.at(node_source) = true;
-  std::deque<int> queue{node_source};
-  while (!queue.empty())
-  {
-    const int node = queue.front();
-    queue.pop_front();
-    for (auto it = boost::out_edges(node, G); it.first != it.second; it.first++)
-    {
-      const int next_node = boost::target(*it.first, G);
-      if (rc_map[*it.first] > 0 && !visited_by_node.at(next_node))
-      {
-        visited_by_node.at(next_node) = true;
-        queue.push_back(next_node);
-      }
-    }
-  }
+  network.max_flow(node_source, node_sink);
+  const std::vector<bool> visited_by_node = network.reachable_from(node_source);
 
   int max_knights = 0;
   for (int i = 0; i < n; i++)